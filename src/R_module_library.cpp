@@ -1,5 +1,7 @@
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <algorithm>                       // for std::find
 #include <exception>                       // for std::exception
 #include <Rinternals.h>                    // for Rf_error
 #include "framework/state_map.h"           // for string_vector
@@ -7,6 +9,7 @@
 #include "framework/module_creator.h"      // for module_creator
 #include "framework/module_factory.h"
 #include "module_library/module_library.h"
+#include "module_library/switching_functions.h"  // for switching_function
 #include "R_module_library.h"
 
 // When creating a new module library R package, it will be necessary to modify
@@ -117,4 +120,97 @@ SEXP R_get_all_quantities()
         Rf_error("Caught unhandled exception in R_get_all_quantities.");
     }
 }
+
+/**
+ *  @brief Returns the switching functions declared by each of the named
+ *  modules; see `module_library/switching_functions.h` for more details.
+ *  Modules that do not declare any, including modules that are not in the
+ *  library, have an empty list.
+ *
+ *  @param [in] module_names The names of the modules
+ *
+ *  @return An R list with one element for each module. Each element is itself
+ *          a list with one element for each of the module's switching
+ *          functions, which is a list with named `quantity`, `thresholds`,
+ *          and `offset` elements.
+ */
+SEXP R_module_switching_functions(SEXP module_names)
+{
+    try {
+        string_vector names = make_vector(module_names);
+        size_t n = names.size();
+        SEXP result = PROTECT(Rf_allocVector(VECSXP, n));
+
+        SEXP element_names = PROTECT(Rf_allocVector(STRSXP, 3));
+        SET_STRING_ELT(element_names, 0, Rf_mkChar("quantity"));
+        SET_STRING_ELT(element_names, 1, Rf_mkChar("thresholds"));
+        SET_STRING_ELT(element_names, 2, Rf_mkChar("offset"));
+
+        for (size_t i = 0; i < n; ++i) {
+            auto const it = library::switching_entries.find(names[i]);
+
+            std::vector<switching_function> const functions =
+                it == library::switching_entries.end()
+                    ? std::vector<switching_function>{}
+                    : it->second;
+
+            SEXP module_functions = PROTECT(Rf_allocVector(VECSXP, functions.size()));
+
+            for (size_t j = 0; j < functions.size(); ++j) {
+                SEXP f = PROTECT(Rf_allocVector(VECSXP, 3));
+                SET_VECTOR_ELT(f, 0, Rf_mkString(functions[j].quantity.c_str()));
+                SET_VECTOR_ELT(f, 1, r_string_vector_from_vector(functions[j].thresholds));
+                SET_VECTOR_ELT(f, 2, Rf_ScalarReal(functions[j].offset));
+                Rf_setAttrib(f, R_NamesSymbol, element_names);
+
+                SET_VECTOR_ELT(module_functions, j, f);
+                UNPROTECT(1);  // UNPROTECT f
+            }
+
+            SET_VECTOR_ELT(result, i, module_functions);
+            UNPROTECT(1);  // UNPROTECT module_functions
+        }
+
+        UNPROTECT(2);  // UNPROTECT element_names and result
+        return result;
+
+    } catch (std::exception const& e) {
+        Rf_error((string("Caught exception in R_module_switching_functions: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_module_switching_functions.");
+    }
+}
+
+/**
+ *  @brief Indicates whether each of the named modules is history-dependent; see
+ *  `module_library::history_dependent_entries` for more details. Modules that
+ *  are not in the library are not history-dependent.
+ *
+ *  @param [in] module_names The names of the modules
+ *
+ *  @return An R logical vector with one element for each module
+ */
+SEXP R_module_history_dependence(SEXP module_names)
+{
+    try {
+        string_vector names = make_vector(module_names);
+        size_t n = names.size();
+        SEXP result = PROTECT(Rf_allocVector(LGLSXP, n));
+
+        string_vector const& entries = library::history_dependent_entries;
+
+        for (size_t i = 0; i < n; ++i) {
+            LOGICAL(result)[i] =
+                std::find(entries.begin(), entries.end(), names[i]) != entries.end();
+        }
+
+        UNPROTECT(1);  // UNPROTECT result
+        return result;
+
+    } catch (std::exception const& e) {
+        Rf_error((string("Caught exception in R_module_history_dependence: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_module_history_dependence.");
+    }
+}
 }
@@ -6,5 +6,7 @@
 extern "C" SEXP R_module_creators(SEXP module_names);
 extern "C" SEXP R_get_all_modules();
 extern "C" SEXP R_get_all_quantities();
+extern "C" SEXP R_module_switching_functions(SEXP module_names);
+extern "C" SEXP R_module_history_dependence(SEXP module_names);
 
 #endif
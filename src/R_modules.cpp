@@ -1,5 +1,9 @@
 #include <string>
+#include <vector>
+#include <atomic>                          // for std::atomic
+#include <algorithm>                       // for std::max
 #include <exception>                       // for std::exception
+#include <stdexcept>                       // for std::runtime_error
 #include <Rinternals.h>                    // for Rf_error and Rprintf
 #include <memory>                          // for unique_ptr
 #include "framework/R_helper_functions.h"  // for mc_vector_from_list, list_from_module_info, list_from_map
@@ -7,8 +11,10 @@
 #include "framework/module_creator.h"
 #include "framework/module.h"
 #include "R_modules.h"
+#include "worker_threads.h"                // for worker_count, run_on_worker_threads
 
 using std::string;
+using std::vector;
 
 extern "C" {
 
@@ -31,6 +37,8 @@ SEXP R_module_info(SEXP mw_ptr_vec, SEXP verbose)
         // Get the module_creator pointer
         module_creator* w = mc_vector_from_list(mw_ptr_vec)[0];
 
+        bool const recreate_module = LOGICAL(history_dependent)[0];
+
         // Convert verbose to a boolean
         bool loquacious = LOGICAL(VECTOR_ELT(verbose, 0))[0];
 
@@ -164,6 +172,8 @@ SEXP R_evaluate_module(SEXP mw_ptr_vec, SEXP input_quantities)
         // Get the module_creator pointer
         module_creator* w = mc_vector_from_list(mw_ptr_vec)[0];
 
+        bool const recreate_module = LOGICAL(history_dependent)[0];
+
         // input_quantities should be a state map
         // use it to initialize the quantity list
         state_map quantities = map_from_list(input_quantities);
@@ -194,4 +204,198 @@ SEXP R_evaluate_module(SEXP mw_ptr_vec, SEXP input_quantities)
     }
 }
 
+/**
+ *  @brief Determines the values of a module's output quantities for many sets
+ *         of input quantity values
+ *
+ *  Rather than converting the inputs and creating the module separately for
+ *  each set of values, as would happen when calling `R_evaluate_module()`
+ *  repeatedly, the module is created once and its input quantities are
+ *  changed in place before each evaluation. The sets of values can optionally
+ *  be divided among several threads, where each thread has its own copy of the
+ *  module and its quantities. No R functions are called by the worker threads;
+ *  any errors are reported once all of them have finished.
+ *
+ *  Some modules, such as `thermal_time_senescence`, remember the inputs they
+ *  received each time they ran. Reusing one of them would make each result
+ *  depend on the earlier rows in the same block, and therefore on the number
+ *  of threads, so it is created again for each set of values instead.
+ *
+ *  @param [in] mw_ptr_vec A single-element vector containing one R external
+ *              pointer pointing to a module_creator object, typically
+ *              produced by the `R_module_creators()` function. If the
+ *              vector has more than one element, only the first will be used.
+ *
+ *  @param [in] input_quantities A list of named numeric vectors where the name
+ *              of each element corresponds to one of the module's input
+ *              quantities. Each vector must have length 1, in which case its
+ *              value is used for every evaluation, or the same length as the
+ *              longest vector, which determines the number of evaluations.
+ *
+ *  @param [in] nthreads An R numeric vector whose first element specifies the
+ *              number of threads to use; values less than 1 indicate that the
+ *              number of threads should be chosen automatically
+ *
+ *  @param [in] history_dependent An R logical vector with one element
+ *              indicating whether the module is history-dependent, in which
+ *              case it is created again for each set of values
+ *
+ *  @return A list of named numeric vectors where the name of each element
+ *          corresponds to one of the module's output quantities and the
+ *          elements of each vector correspond to the sets of input values
+ */
+SEXP R_evaluate_module_batch(
+    SEXP mw_ptr_vec,
+    SEXP input_quantities,
+    SEXP nthreads,
+    SEXP history_dependent)
+{
+    try {
+        // Get the module_creator pointer
+        module_creator* w = mc_vector_from_list(mw_ptr_vec)[0];
+
+        bool const recreate_module = LOGICAL(history_dependent)[0];
+
+        // Get the names and values of the inputs on this thread
+        size_t const n_inputs = Rf_length(input_quantities);
+        SEXP input_names = Rf_getAttrib(input_quantities, R_NamesSymbol);
+
+        if (n_inputs > 0 && Rf_isNull(input_names)) {
+            throw std::runtime_error("The input quantities must be named");
+        }
+
+        vector<string> names(n_inputs);
+        vector<double const*> values(n_inputs);
+        vector<size_t> lengths(n_inputs);
+        size_t n_rows = n_inputs > 0 ? 0 : 1;
+
+        for (size_t j = 0; j < n_inputs; ++j) {
+            SEXP v = VECTOR_ELT(input_quantities, j);
+            if (!Rf_isReal(v)) {
+                throw std::runtime_error(
+                    string("The input quantity `") + CHAR(STRING_ELT(input_names, j)) +
+                    "` must be a numeric vector");
+            }
+            names[j] = CHAR(STRING_ELT(input_names, j));
+            values[j] = REAL(v);
+            lengths[j] = Rf_length(v);
+            n_rows = std::max(n_rows, lengths[j]);
+        }
+
+        for (size_t j = 0; j < n_inputs; ++j) {
+            if (lengths[j] != 1 && lengths[j] != n_rows) {
+                throw std::runtime_error(
+                    "The input quantity `" + names[j] + "` has length " +
+                    std::to_string(lengths[j]) + ", but each input must have " +
+                    "length 1 or " + std::to_string(n_rows));
+            }
+        }
+
+        // Allocate the output vectors on this thread; the workers only write
+        // to the elements for their own rows
+        string_vector module_outputs = w->get_outputs();
+        size_t const n_outputs = module_outputs.size();
+
+        SEXP result = PROTECT(Rf_allocVector(VECSXP, n_outputs));
+        SEXP result_names = PROTECT(Rf_allocVector(STRSXP, n_outputs));
+        vector<double*> output_values(n_outputs);
+
+        for (size_t k = 0; k < n_outputs; ++k) {
+            SEXP v = Rf_allocVector(REALSXP, n_rows);
+            SET_VECTOR_ELT(result, k, v);
+            SET_STRING_ELT(result_names, k, Rf_mkChar(module_outputs[k].c_str()));
+            output_values[k] = REAL(v);
+        }
+        Rf_setAttrib(result, R_NamesSymbol, result_names);
+
+        // Determine the number of threads
+        size_t const n_workers = worker_count(REAL(nthreads)[0], n_rows);
+
+        // Each worker evaluates one contiguous block of rows; the blocks are
+        // claimed in order by the threads as they start
+        vector<string> errors(n_workers);
+        std::atomic<size_t> next_block{0};
+
+        auto worker = [&]() {
+            size_t const w_index = next_block++;
+            size_t const first_row = n_rows * w_index / n_workers;
+            size_t const last_row = n_rows * (w_index + 1) / n_workers;
+
+            try {
+                state_map quantities;
+                for (size_t j = 0; j < n_inputs; ++j) {
+                    quantities[names[j]] = values[j][0];
+                }
+
+                state_map module_output_map;
+                for (string const& param : module_outputs) {
+                    module_output_map[param] = 0.0;
+                }
+
+                std::unique_ptr<module> module_ptr =
+                    w->create_module(quantities, &module_output_map);
+
+                // The module holds references to the elements of these maps,
+                // so their values can be changed in place
+                vector<double*> input_ptrs(n_inputs);
+                for (size_t j = 0; j < n_inputs; ++j) {
+                    input_ptrs[j] = &quantities.at(names[j]);
+                }
+
+                vector<double*> output_ptrs(n_outputs);
+                for (size_t k = 0; k < n_outputs; ++k) {
+                    output_ptrs[k] = &module_output_map.at(module_outputs[k]);
+                }
+
+                for (size_t i = first_row; i < last_row; ++i) {
+                    for (size_t j = 0; j < n_inputs; ++j) {
+                        *input_ptrs[j] = values[j][lengths[j] == 1 ? 0 : i];
+                    }
+
+                    if (recreate_module) {
+                        module_ptr = w->create_module(quantities, &module_output_map);
+                    }
+
+                    // Derivative modules add their output values to the
+                    // values in module_output_map, so reset them each time
+                    for (double* op : output_ptrs) {
+                        *op = 0.0;
+                    }
+
+                    module_ptr->run();
+
+                    for (size_t k = 0; k < n_outputs; ++k) {
+                        output_values[k][i] = *output_ptrs[k];
+                    }
+                }
+            } catch (std::exception const& e) {
+                errors[w_index] = e.what();
+            } catch (...) {
+                errors[w_index] = "unhandled exception";
+            }
+        };
+
+        if (n_rows > 0) {
+            run_on_worker_threads(n_workers, worker);
+        }
+
+        // Report any problems on this thread
+        for (string const& e : errors) {
+            if (!e.empty()) {
+                throw std::runtime_error(e);
+            }
+        }
+
+        UNPROTECT(2);  // UNPROTECT result and result_names
+        return result;
+
+    } catch (quantity_access_error const& qae) {
+        Rf_error((string("Caught quantity access error in R_evaluate_module_batch: ") + qae.what()).c_str());
+    } catch (std::exception const& e) {
+        Rf_error((string("Caught exception in R_evaluate_module_batch: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_evaluate_module_batch.");
+    }
+}
+
 }  // extern "C"
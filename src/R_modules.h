@@ -5,5 +5,6 @@
 
 extern "C" SEXP R_module_info(SEXP mw_ptr_vec, SEXP verbose);
 extern "C" SEXP R_evaluate_module(SEXP mw_ptr_vec, SEXP input_quantities);
+extern "C" SEXP R_evaluate_module_batch(SEXP mw_ptr_vec, SEXP input_quantities, SEXP nthreads, SEXP history_dependent);
 
 #endif
@@ -0,0 +1,248 @@
+#include <string>
+#include <vector>
+#include <exception>                       // for std::exception
+#include <stdexcept>                       // for std::runtime_error
+#include <memory>                          // for std::unique_ptr
+#include <Rinternals.h>                    // for Rf_error and Rprintf
+#include "framework/R_helper_functions.h"  // for map_from_list, map_vector_from_list, mc_vector_from_list
+#include "framework/state_map.h"           // for state_map, state_vector_map
+#include "framework/module_creator.h"      // for mc_vector
+#include "framework/biocro_simulation.h"
+#include "R_simulation_result.h"
+#include "R_prepared_simulation.h"
+
+using std::string;
+
+namespace
+{
+/**
+ *  @brief Stores the C++ versions of the inputs to a simulation so they only
+ *  need to be converted from R objects once, even when the simulation is run
+ *  many times with different parameter or initial values.
+ *
+ *  The quantities whose values change between runs are resolved to pointers
+ *  into `initial_values` and `parameters` when the simulation is prepared, so
+ *  each run only copies a plain vector of new values into these slots without
+ *  looking up any names. (Pointers to the elements of a `state_map` remain
+ *  valid as long as no elements are erased.)
+ */
+struct prepared_simulation {
+    state_map initial_values;
+    state_map parameters;
+    state_vector_map drivers;
+    mc_vector direct_mcs;
+    mc_vector differential_mcs;
+    string solver_type;
+    double output_step_size;
+    double adaptive_rel_error_tol;
+    double adaptive_abs_error_tol;
+    int adaptive_max_steps;
+    std::vector<double*> argument_slots;
+};
+
+void finalize_prepared_simulation(SEXP ps_ptr)
+{
+    delete static_cast<prepared_simulation*>(R_ExternalPtrAddr(ps_ptr));
+    R_ClearExternalPtr(ps_ptr);
+}
+
+prepared_simulation* prepared_simulation_from_pointer(SEXP ps_ptr)
+{
+    prepared_simulation* ps =
+        static_cast<prepared_simulation*>(R_ExternalPtrAddr(ps_ptr));
+
+    if (!ps) {
+        throw std::runtime_error(
+            "The prepared simulation is no longer available; it may have been "
+            "saved and restored from a previous R session.");
+    }
+
+    return ps;
+}
+
+/**
+ *  @brief Returns pointers to the values of the quantities that will be changed
+ *  each time a prepared simulation is run.
+ *
+ *  Each element of `argument_controls` must be either `"initial_values"` or
+ *  `"parameters"`, indicating where the quantity with the corresponding name in
+ *  `argument_names` can be found. Since the prepared simulation already
+ *  includes a value for every quantity, only values may be changed; attempting
+ *  to add a new quantity is an error.
+ */
+std::vector<double*> resolve_argument_slots(
+    prepared_simulation& ps,
+    SEXP const& argument_controls,
+    SEXP const& argument_names)
+{
+    R_xlen_t const n = Rf_length(argument_names);
+
+    std::vector<double*> slots(n);
+
+    for (R_xlen_t i = 0; i < n; ++i) {
+        string const control = CHAR(STRING_ELT(argument_controls, i));
+        string const name = CHAR(STRING_ELT(argument_names, i));
+
+        state_map& quantities =
+            control == "initial_values" ? ps.initial_values : ps.parameters;
+
+        auto it = quantities.find(name);
+        if (it == quantities.end()) {
+            string const quantity_type =
+                control == "initial_values" ? "initial values" : "parameters";
+
+            throw std::runtime_error(
+                "`" + name + "` is not one of the " + quantity_type +
+                " used to prepare the simulation");
+        }
+
+        slots[i] = &(it->second);
+    }
+
+    return slots;
+}
+
+}  // namespace
+
+extern "C" {
+
+/**
+ *  @brief Converts the inputs to a simulation into C++ objects and stores them
+ *  in a `prepared_simulation` object, which is returned as an R external
+ *  pointer.
+ *
+ *  The R external pointer takes ownership of the `prepared_simulation` object
+ *  and deletes it when the pointer is garbage collected. The R lists of module
+ *  creators are stored in the `prot` field of the pointer so that the module
+ *  creators remain valid for as long as the prepared simulation exists.
+ *
+ *  The `argument_controls` and `argument_names` inputs are R character vectors
+ *  that specify which initial values and parameters will be changed by
+ *  `R_run_prepared_simulation()`, and in which order; their names are resolved
+ *  here so that they do not need to be looked up on every run. The other
+ *  arguments are the same as the corresponding arguments of `R_run_biocro()`.
+ *
+ *  @return An R external pointer to a `prepared_simulation` object, which can
+ *          be passed to `R_run_prepared_simulation()`
+ */
+SEXP R_prepare_simulation(
+    SEXP initial_values,
+    SEXP parameters,
+    SEXP drivers,
+    SEXP direct_mc_vec,
+    SEXP differential_mc_vec,
+    SEXP solver_type,
+    SEXP solver_output_step_size,
+    SEXP solver_adaptive_rel_error_tol,
+    SEXP solver_adaptive_abs_error_tol,
+    SEXP solver_adaptive_max_steps,
+    SEXP argument_controls,
+    SEXP argument_names)
+{
+    try {
+        std::unique_ptr<prepared_simulation> ps(new prepared_simulation{
+            map_from_list(initial_values),
+            map_from_list(parameters),
+            map_vector_from_list(drivers),
+            mc_vector_from_list(direct_mc_vec),
+            mc_vector_from_list(differential_mc_vec),
+            CHAR(STRING_ELT(solver_type, 0)),
+            REAL(solver_output_step_size)[0],
+            REAL(solver_adaptive_rel_error_tol)[0],
+            REAL(solver_adaptive_abs_error_tol)[0],
+            (int)REAL(solver_adaptive_max_steps)[0],
+            {}});
+
+        ps->argument_slots =
+            resolve_argument_slots(*ps, argument_controls, argument_names);
+
+        SEXP mc_lists = PROTECT(Rf_allocVector(VECSXP, 2));
+        SET_VECTOR_ELT(mc_lists, 0, direct_mc_vec);
+        SET_VECTOR_ELT(mc_lists, 1, differential_mc_vec);
+
+        SEXP ps_ptr =
+            PROTECT(R_MakeExternalPtr(ps.release(), R_NilValue, mc_lists));
+
+        R_RegisterCFinalizerEx(
+            ps_ptr,
+            (R_CFinalizer_t)finalize_prepared_simulation,
+            TRUE);
+
+        UNPROTECT(2);  // UNPROTECT mc_lists and ps_ptr
+        return ps_ptr;
+
+    } catch (std::exception const& e) {
+        Rf_error((string("Caught exception in R_prepare_simulation: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_prepare_simulation.");
+    }
+}
+
+/**
+ *  @brief Runs a prepared simulation after replacing the values of the initial
+ *  values and parameters that were specified when it was prepared
+ *
+ *  @param [in] prepared_simulation_ptr An R external pointer produced by
+ *              `R_prepare_simulation()`
+ *
+ *  @param [in] argument_values An R numeric vector of new values for the
+ *              quantities specified by the `argument_controls` and
+ *              `argument_names` used to prepare the simulation, in the same
+ *              order; these values remain in place for subsequent runs
+ *
+ *  @param [in] verbose When verbose is TRUE, print solver information to the R
+ *              console
+ *
+ *  @return An R list formatted like the output from `R_run_biocro()`
+ */
+SEXP R_run_prepared_simulation(
+    SEXP prepared_simulation_ptr,
+    SEXP argument_values,
+    SEXP verbose)
+{
+    try {
+        prepared_simulation* ps =
+            prepared_simulation_from_pointer(prepared_simulation_ptr);
+
+        size_t const n = ps->argument_slots.size();
+
+        if (static_cast<size_t>(Rf_length(argument_values)) != n) {
+            throw std::runtime_error(
+                "The number of argument values does not match the number of "
+                "arguments used to prepare the simulation");
+        }
+
+        double const* values = REAL(argument_values);
+        for (size_t i = 0; i < n; ++i) {
+            *(ps->argument_slots[i]) = values[i];
+        }
+
+        if (ps->drivers.begin()->second.size() == 0) {
+            return R_NilValue;
+        }
+
+        bool loquacious = LOGICAL(VECTOR_ELT(verbose, 0))[0];
+
+        biocro_simulation gro(
+            ps->initial_values, ps->parameters, ps->drivers,
+            ps->direct_mcs, ps->differential_mcs,
+            ps->solver_type, ps->output_step_size,
+            ps->adaptive_rel_error_tol, ps->adaptive_abs_error_tol,
+            ps->adaptive_max_steps);
+
+        state_vector_map result = gro.run_simulation();
+
+        if (loquacious) {
+            Rprintf("%s", gro.generate_report().c_str());
+        }
+
+        return list_from_result(result);
+
+    } catch (std::exception const& e) {
+        Rf_error((string("Caught exception in R_run_prepared_simulation: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_run_prepared_simulation.");
+    }
+}
+
+}  // extern "C"
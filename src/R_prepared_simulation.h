@@ -0,0 +1,25 @@
+#ifndef R_PREPARED_SIMULATION_H
+#define R_PREPARED_SIMULATION_H
+
+#include <Rinternals.h>  // for SEXP
+
+extern "C" SEXP R_prepare_simulation(
+    SEXP initial_values,
+    SEXP parameters,
+    SEXP drivers,
+    SEXP direct_mc_vec,
+    SEXP differential_mc_vec,
+    SEXP solver_type,
+    SEXP solver_output_step_size,
+    SEXP solver_adaptive_rel_error_tol,
+    SEXP solver_adaptive_abs_error_tol,
+    SEXP solver_adaptive_max_steps,
+    SEXP argument_controls,
+    SEXP argument_names);
+
+extern "C" SEXP R_run_prepared_simulation(
+    SEXP prepared_simulation_ptr,
+    SEXP argument_values,
+    SEXP verbose);
+
+#endif
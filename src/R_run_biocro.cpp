@@ -1,13 +1,61 @@
 #include <string>
+#include <vector>
+#include <atomic>                          // for std::atomic
+#include <algorithm>                       // for std::find
 #include <exception>                       // for std::exception
+#include <stdexcept>                       // for std::runtime_error
 #include <Rinternals.h>                    // for Rf_error and Rprintf
-#include "framework/R_helper_functions.h"  // for map_from_list, map_vector_from_list, mc_vector_from_list, list_from_map
+#include "framework/R_helper_functions.h"  // for map_from_list, map_vector_from_list, mc_vector_from_list, make_vector
 #include "framework/state_map.h"           // for state_map, state_vector_map, string_vector
 #include "framework/module_creator.h"      // for mc_vector
 #include "framework/biocro_simulation.h"
+#include "module_profiler.h"
+#include "R_simulation_result.h"
 #include "R_run_biocro.h"
+#include "worker_threads.h"                // for worker_count, run_on_worker_threads
 
 using std::string;
+using std::vector;
+
+namespace
+{
+/**
+ *  @brief Converts module timing statistics into a named R list with one
+ *  numeric vector for each statistic, where the elements of each vector
+ *  correspond to the elements of `timings`
+ */
+SEXP list_from_timings(vector<module_timing> const& timings)
+{
+    R_xlen_t const n = timings.size();
+
+    SEXP calls = PROTECT(Rf_allocVector(REALSXP, n));
+    SEXP total_time = PROTECT(Rf_allocVector(REALSXP, n));
+    SEXP max_time = PROTECT(Rf_allocVector(REALSXP, n));
+
+    for (R_xlen_t i = 0; i < n; ++i) {
+        REAL(calls)[i] = timings[i].calls;
+        REAL(total_time)[i] = timings[i].total_seconds;
+        REAL(max_time)[i] = timings[i].max_seconds;
+    }
+
+    SEXP list = PROTECT(Rf_allocVector(VECSXP, 3));
+    SEXP names = PROTECT(Rf_allocVector(STRSXP, 3));
+
+    SET_VECTOR_ELT(list, 0, calls);
+    SET_VECTOR_ELT(list, 1, total_time);
+    SET_VECTOR_ELT(list, 2, max_time);
+
+    SET_STRING_ELT(names, 0, Rf_mkChar("calls"));
+    SET_STRING_ELT(names, 1, Rf_mkChar("total_time"));
+    SET_STRING_ELT(names, 2, Rf_mkChar("max_time"));
+
+    Rf_setAttrib(list, R_NamesSymbol, names);
+
+    UNPROTECT(5);  // UNPROTECT calls, total_time, max_time, list, and names
+    return list;
+}
+
+}  // namespace
 
 extern "C" {
 
@@ -22,7 +70,9 @@ SEXP R_run_biocro(
     SEXP solver_adaptive_rel_error_tol,
     SEXP solver_adaptive_abs_error_tol,
     SEXP solver_adaptive_max_steps,
-    SEXP verbose)
+    SEXP verbose,
+    SEXP output_quantities,
+    SEXP profile)
 {
     try {
         state_map iv = map_from_list(initial_values);
@@ -43,6 +93,16 @@ SEXP R_run_biocro(
         double adaptive_abs_error_tol = REAL(solver_adaptive_abs_error_tol)[0];
         int adaptive_max_steps = (int)REAL(solver_adaptive_max_steps)[0];
 
+        // When profiling is requested, the simulation is built from module
+        // creators that time each module; otherwise the original creators are
+        // used and there is no profiling overhead
+        bool const use_profiler = LOGICAL(profile)[0];
+        module_profiler profiler;
+        if (use_profiler) {
+            direct_mcs = profiler.wrap(direct_mcs);
+            differential_mcs = profiler.wrap(differential_mcs);
+        }
+
         biocro_simulation gro(iv, p, d, direct_mcs, differential_mcs,
                               solver_type_string, output_step_size,
                               adaptive_rel_error_tol, adaptive_abs_error_tol,
@@ -50,10 +110,24 @@ SEXP R_run_biocro(
         state_vector_map result = gro.run_simulation();
 
         if (loquacious) {
-            Rprintf(gro.generate_report().c_str());
+            Rprintf("%s", gro.generate_report().c_str());
+        }
+
+        string_vector output_names = make_vector(output_quantities);
+        if (!output_names.empty()) {
+            keep_result_columns(result, output_names);
+        }
+
+        SEXP r_result = PROTECT(list_from_result(result));
+
+        if (use_profiler) {
+            SEXP r_profile = PROTECT(list_from_timings(profiler.get_timings()));
+            Rf_setAttrib(r_result, Rf_install("profile"), r_profile);
+            UNPROTECT(1);  // UNPROTECT r_profile
         }
 
-        return list_from_map(result);
+        UNPROTECT(1);  // UNPROTECT r_result
+        return r_result;
     } catch (std::exception const& e) {
         Rf_error(string(string("Caught exception in R_run_biocro: ") + e.what()).c_str());
     } catch (...) {
@@ -61,4 +135,178 @@ SEXP R_run_biocro(
     }
 }
 
+/**
+ *  @brief Runs several independent simulations that share the same modules and
+ *         ODE solver settings, distributing them across a pool of worker
+ *         threads
+ *
+ *  All conversions between R and C++ objects take place on the calling thread,
+ *  both before the workers are started and after they have finished, so the
+ *  workers never touch the R API. The module creators are shared by all of the
+ *  simulations; this is safe because they are only used to create new module
+ *  objects, which belong to a single simulation.
+ *
+ *  If any ensemble member fails, an error is reported for the first member
+ *  (in order) that failed after all the workers have finished.
+ *
+ *  @param [in] initial_values An R list where each element is a list of named
+ *              initial values for one ensemble member
+ *
+ *  @param [in] parameters An R list where each element is a list of named
+ *              parameters for one ensemble member
+ *
+ *  @param [in] drivers An R list where each element is a list of named driver
+ *              vectors for one ensemble member
+ *
+ *  @param [in] nthreads An R numeric vector whose first element specifies the
+ *              number of worker threads to use; values less than 1 indicate
+ *              that the number of threads should be chosen automatically
+ *
+ *  The remaining arguments are the same as the corresponding arguments of
+ *  `R_run_biocro()` and are shared by all ensemble members.
+ *
+ *  @return An R list with one element for each ensemble member, where each
+ *          element is formatted like the output from `R_run_biocro()`
+ */
+SEXP R_run_biocro_ensemble(
+    SEXP initial_values,
+    SEXP parameters,
+    SEXP drivers,
+    SEXP direct_mc_vec,
+    SEXP differential_mc_vec,
+    SEXP solver_type,
+    SEXP solver_output_step_size,
+    SEXP solver_adaptive_rel_error_tol,
+    SEXP solver_adaptive_abs_error_tol,
+    SEXP solver_adaptive_max_steps,
+    SEXP nthreads,
+    SEXP verbose)
+{
+    try {
+        size_t const n_members = Rf_length(initial_values);
+
+        if (static_cast<size_t>(Rf_length(parameters)) != n_members ||
+            static_cast<size_t>(Rf_length(drivers)) != n_members) {
+            throw std::runtime_error(
+                "The initial_values, parameters, and drivers must have the "
+                "same number of ensemble members");
+        }
+
+        // Convert the inputs from R formats on this thread. The drivers are
+        // usually much larger than the other inputs and are often shared by
+        // many members (e.g., when sweeping over parameter values), so each
+        // distinct R drivers object is only converted once and its C++ copy is
+        // shared by all members that use it.
+        vector<state_map> iv(n_members);
+        vector<state_map> p(n_members);
+        vector<state_vector_map> unique_d;
+        vector<size_t> d_index(n_members);
+
+        unique_d.reserve(n_members);
+        vector<SEXP> unique_d_sexp;
+
+        for (size_t i = 0; i < n_members; ++i) {
+            iv[i] = map_from_list(VECTOR_ELT(initial_values, i));
+            p[i] = map_from_list(VECTOR_ELT(parameters, i));
+
+            SEXP member_drivers = VECTOR_ELT(drivers, i);
+            auto it = std::find(
+                unique_d_sexp.begin(), unique_d_sexp.end(), member_drivers);
+
+            if (it == unique_d_sexp.end()) {
+                d_index[i] = unique_d.size();
+                unique_d_sexp.push_back(member_drivers);
+                unique_d.push_back(map_vector_from_list(member_drivers));
+            } else {
+                d_index[i] = it - unique_d_sexp.begin();
+            }
+        }
+
+        mc_vector direct_mcs = mc_vector_from_list(direct_mc_vec);
+        mc_vector differential_mcs = mc_vector_from_list(differential_mc_vec);
+
+        bool loquacious = LOGICAL(VECTOR_ELT(verbose, 0))[0];
+        string solver_type_string = CHAR(STRING_ELT(solver_type, 0));
+        double output_step_size = REAL(solver_output_step_size)[0];
+        double adaptive_rel_error_tol = REAL(solver_adaptive_rel_error_tol)[0];
+        double adaptive_abs_error_tol = REAL(solver_adaptive_abs_error_tol)[0];
+        int adaptive_max_steps = (int)REAL(solver_adaptive_max_steps)[0];
+
+        // Determine the number of worker threads
+        size_t const n_workers = worker_count(REAL(nthreads)[0], n_members);
+
+        // Storage for the results, solver reports, and error messages, where
+        // each worker only writes to the elements for its own members
+        vector<state_vector_map> results(n_members);
+        vector<string> reports(n_members);
+        vector<string> errors(n_members);
+
+        // Each worker claims the next unprocessed member until none remain
+        std::atomic<size_t> next_member{0};
+
+        auto worker = [&]() {
+            for (size_t i = next_member++; i < n_members; i = next_member++) {
+                try {
+                    state_vector_map const& d = unique_d[d_index[i]];
+
+                    if (d.begin()->second.size() == 0) {
+                        continue;
+                    }
+
+                    biocro_simulation gro(
+                        iv[i], p[i], d, direct_mcs, differential_mcs,
+                        solver_type_string, output_step_size,
+                        adaptive_rel_error_tol, adaptive_abs_error_tol,
+                        adaptive_max_steps);
+
+                    results[i] = gro.run_simulation();
+
+                    if (loquacious) {
+                        reports[i] = gro.generate_report();
+                    }
+                } catch (std::exception const& e) {
+                    errors[i] = e.what();
+                } catch (...) {
+                    errors[i] = "unhandled exception";
+                }
+            }
+        };
+
+        run_on_worker_threads(n_workers, worker);
+
+        // Report any problems and send the results back to R on this thread
+        for (size_t i = 0; i < n_members; ++i) {
+            if (!errors[i].empty()) {
+                throw std::runtime_error(
+                    "ensemble member " + std::to_string(i + 1) + ": " + errors[i]);
+            }
+        }
+
+        SEXP ensemble_result = PROTECT(Rf_allocVector(VECSXP, n_members));
+
+        for (size_t i = 0; i < n_members; ++i) {
+            if (loquacious) {
+                Rprintf("\nEnsemble member %i:\n", (int)(i + 1));
+                Rprintf("%s", reports[i].c_str());
+            }
+
+            if (!results[i].empty()) {
+                SET_VECTOR_ELT(ensemble_result, i, list_from_result(results[i]));
+            }
+
+            // Release any storage still held by this member's (now empty)
+            // result before converting the next one
+            state_vector_map().swap(results[i]);
+        }
+
+        UNPROTECT(1);  // UNPROTECT ensemble_result
+        return ensemble_result;
+
+    } catch (std::exception const& e) {
+        Rf_error(string(string("Caught exception in R_run_biocro_ensemble: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_run_biocro_ensemble.");
+    }
+}
+
 }  // extern "C"
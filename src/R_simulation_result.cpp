@@ -0,0 +1,89 @@
+#include <algorithm>              // for std::copy, std::find
+#include <iterator>               // for std::next
+#include <stdexcept>              // for std::runtime_error
+#include <string>
+#include <Rinternals.h>           // for Rf_allocVector, SET_VECTOR_ELT, etc
+#include "framework/state_map.h"  // for state_vector_map, string_vector
+#include "R_simulation_result.h"
+
+/**
+ *  @brief Converts the result of a simulation into a named R list of numeric
+ *  vectors, consuming the result in the process
+ *
+ *  This produces the same R object as `list_from_map()`, but each column of
+ *  `result` is erased as soon as it has been copied into its R vector. Since
+ *  the result and its R copy are never both held in memory in their entirety,
+ *  this roughly halves the peak memory needed to return a long simulation with
+ *  many output quantities to R.
+ *
+ *  @param [in,out] result The output from `biocro_simulation::run_simulation()`;
+ *                  it will be empty when this function returns
+ *
+ *  @return A named R list with one numeric vector for each quantity in
+ *          `result`
+ */
+SEXP list_from_result(state_vector_map& result)
+{
+    R_xlen_t const n_columns = result.size();
+
+    SEXP list = PROTECT(Rf_allocVector(VECSXP, n_columns));
+    SEXP names = PROTECT(Rf_allocVector(STRSXP, n_columns));
+
+    R_xlen_t i = 0;
+    for (auto it = result.begin(); it != result.end(); ++i) {
+        std::vector<double> const& values = it->second;
+
+        // The new column is protected once it is an element of `list`
+        SEXP column = Rf_allocVector(REALSXP, values.size());
+        SET_VECTOR_ELT(list, i, column);
+        std::copy(values.begin(), values.end(), REAL(column));
+
+        SET_STRING_ELT(names, i, Rf_mkChar(it->first.c_str()));
+
+        it = result.erase(it);
+    }
+
+    Rf_setAttrib(list, R_NamesSymbol, names);
+
+    UNPROTECT(2);  // UNPROTECT list and names
+    return list;
+}
+
+/**
+ *  @brief Removes all columns from the result of a simulation except the ones
+ *  named in `output_quantities` and `time`, which is always kept
+ *
+ *  This is applied before the result is converted into an R object, so the
+ *  columns that are removed are never copied into R.
+ *
+ *  @param [in,out] result The output from `biocro_simulation::run_simulation()`
+ *
+ *  @param [in] output_quantities The names of the quantities to keep; an
+ *              exception is thrown if any of them are not in `result`
+ */
+void keep_result_columns(
+    state_vector_map& result,
+    string_vector const& output_quantities)
+{
+    std::string unknown_quantities;
+    for (std::string const& name : output_quantities) {
+        if (result.find(name) == result.end()) {
+            unknown_quantities += " " + name;
+        }
+    }
+
+    if (!unknown_quantities.empty()) {
+        throw std::runtime_error(
+            "The following `output_quantities` are not calculated by the "
+            "simulation:" + unknown_quantities);
+    }
+
+    for (auto it = result.begin(); it != result.end();) {
+        bool const keep =
+            it->first == "time" ||
+            std::find(output_quantities.begin(), output_quantities.end(),
+                      it->first) != output_quantities.end();
+
+        it = keep ? std::next(it) : result.erase(it);
+    }
+}
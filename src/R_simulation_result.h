@@ -0,0 +1,13 @@
+#ifndef R_SIMULATION_RESULT_H
+#define R_SIMULATION_RESULT_H
+
+#include <Rinternals.h>           // for SEXP
+#include "framework/state_map.h"  // for state_vector_map, string_vector
+
+SEXP list_from_result(state_vector_map& result);
+
+void keep_result_columns(
+    state_vector_map& result,
+    string_vector const& output_quantities);
+
+#endif
@@ -1,27 +1,303 @@
 #include <vector>
 #include <string>
+#include <cmath>                           // for std::sqrt, std::abs
+#include <limits>                          // for std::numeric_limits
+#include <algorithm>                       // for std::max, std::max_element, std::fill
+#include <unordered_map>
+#include <memory>                          // for std::unique_ptr
 #include <exception>                       // for std::exception
+#include <stdexcept>                       // for std::runtime_error
 #include <Rinternals.h>                    // for Rf_error
-#include "framework/R_helper_functions.h"  // for map_from_list, map_vector_from_list, mc_vector_from_list, list_from_map
+#include "framework/R_helper_functions.h"  // for map_from_list, map_vector_from_list, mc_vector_from_list
+#include "framework/module_creator.h"      // for mc_vector
 #include "framework/state_map.h"           // for state_map, state_vector_map, string_vector
 #include "framework/dynamical_system.h"
+#include "jacobian_sparsity.h"
+#include "R_system_derivatives.h"
 
 using std::string;
 using std::vector;
 
+namespace
+{
+/**
+ *  @brief Stores a `dynamical_system` so it only needs to be created once, even
+ *  when its derivatives are requested many times by an external ODE solver.
+ *
+ *  External solvers such as the ones in the deSolve package supply the values
+ *  of the differential quantities as a plain vector in their own order. The
+ *  position of each of the system's differential quantities in that vector is
+ *  determined when the system is prepared, so each evaluation only copies
+ *  values in and out without looking up any names. The sparsity pattern of the
+ *  Jacobian and the grouping of its columns (see `jacobian_sparsity()` and
+ *  `color_jacobian_columns()`) are also determined once.
+ *
+ *  Some modules, such as `thermal_time_senescence`, remember the inputs they
+ *  received each time they ran, so reusing them would make each evaluation
+ *  depend on all the earlier ones. When `history_dependent` is true, the
+ *  inputs are stored and a new `dynamical_system` is created from them before
+ *  every evaluation of the derivatives, including each of the evaluations
+ *  used to approximate the Jacobian.
+ */
+class prepared_system
+{
+   public:
+    prepared_system(
+        state_map const& differential_quantities,
+        state_map const& parameters,
+        state_vector_map const& drivers,
+        mc_vector const& direct_mcs,
+        mc_vector const& differential_mcs,
+        string_vector const& input_names,
+        bool history_dependent);
+
+    size_t size() const { return position.size(); }
+
+    void derivative(double const* x_in, double t, double* dxdt_out);
+
+    void jacobian(double const* x_in, double t, double* J);
+
+   private:
+    // The inputs used to create the system, which are only stored if it must
+    // be created again before each evaluation
+    struct system_inputs {
+        state_map differential_quantities;
+        state_map parameters;
+        state_vector_map drivers;
+        mc_vector direct_mcs;
+        mc_vector differential_mcs;
+    };
+
+    std::unique_ptr<system_inputs> inputs;
+    std::unique_ptr<dynamical_system> sys;
+
+    // `position[i]` is the position of the system's `i`th differential
+    // quantity in the vectors supplied by the solver
+    vector<size_t> position;
+
+    sparsity_pattern pattern;
+    vector<size_t> colors;
+    size_t n_colors;
+
+    // Storage for the values of the differential quantities and their
+    // derivatives, in the order used by the system
+    vector<double> x;
+    vector<double> xp;
+    vector<double> f0;
+    vector<double> f1;
+    vector<double> h;
+
+    void set_state(double const* x_in);
+
+    void calculate_derivative(vector<double> const& state, vector<double>& dxdt, double t);
+};
+
+prepared_system::prepared_system(
+    state_map const& differential_quantities,
+    state_map const& parameters,
+    state_vector_map const& drivers,
+    mc_vector const& direct_mcs,
+    mc_vector const& differential_mcs,
+    string_vector const& input_names,
+    bool history_dependent)
+    : sys{new dynamical_system(
+          differential_quantities, parameters, drivers, direct_mcs, differential_mcs)}
+{
+    if (history_dependent) {
+        inputs.reset(new system_inputs{
+            differential_quantities, parameters, drivers, direct_mcs, differential_mcs});
+    }
+
+    // Get the differential quantity names in the order used by the system,
+    // which may in general be different than the order used by the solver
+    string_vector const differential_quantity_names =
+        sys->get_differential_quantity_names();
+
+    size_t const n = differential_quantity_names.size();
+
+    if (input_names.size() != n) {
+        throw std::runtime_error(
+            "The number of differential quantities does not match the number "
+            "used by the system");
+    }
+
+    std::unordered_map<string, size_t> input_index;
+    for (size_t i = 0; i < n; ++i) {
+        input_index[input_names[i]] = i;
+    }
+
+    position.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        auto it = input_index.find(differential_quantity_names[i]);
+        if (it == input_index.end()) {
+            throw std::runtime_error(
+                "`" + differential_quantity_names[i] +
+                "` is not one of the differential quantities");
+        }
+        position[i] = it->second;
+    }
+
+    // Group the columns of the Jacobian that can be found from the same
+    // evaluation
+    pattern = jacobian_sparsity(
+        differential_quantity_names, direct_mcs, differential_mcs);
+
+    colors = color_jacobian_columns(pattern);
+
+    n_colors = n == 0 ? 0 : *std::max_element(colors.begin(), colors.end()) + 1;
+
+    x.resize(n);
+    xp.resize(n);
+    f0.resize(n);
+    f1.resize(n);
+    h.resize(n);
+}
+
+void prepared_system::set_state(double const* x_in)
+{
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = x_in[position[i]];
+    }
+}
+
+/**
+ *  @brief Calculates the derivatives at `state`, where both vectors are
+ *  arranged in the order used by the system, first creating a new system if
+ *  its modules depend on their history.
+ */
+void prepared_system::calculate_derivative(
+    vector<double> const& state,
+    vector<double>& dxdt,
+    double t)
+{
+    if (inputs) {
+        sys.reset(new dynamical_system(
+            inputs->differential_quantities, inputs->parameters,
+            inputs->drivers, inputs->direct_mcs, inputs->differential_mcs));
+    }
+
+    sys->calculate_derivative(state, dxdt, t);
+}
+
+/**
+ *  @brief Calculates the derivatives of the differential quantities, where
+ *  `x_in` and `dxdt_out` are arranged in the order used by the solver.
+ */
+void prepared_system::derivative(double const* x_in, double t, double* dxdt_out)
+{
+    set_state(x_in);
+
+    calculate_derivative(x, f0, t);
+
+    for (size_t i = 0; i < f0.size(); ++i) {
+        dxdt_out[position[i]] = f0[i];
+    }
+}
+
+/**
+ *  @brief Approximates the Jacobian matrix using forward finite differences,
+ *  storing it in column-major order in `J`, where rows and columns are arranged
+ *  in the order used by the solver.
+ *
+ *  Rather than one additional evaluation of the derivatives for each column,
+ *  only one is required for each group of columns; elements outside the
+ *  sparsity pattern are set to zero.
+ */
+void prepared_system::jacobian(double const* x_in, double t, double* J)
+{
+    size_t const n = x.size();
+
+    set_state(x_in);
+
+    // Calculate the derivative at the current state
+    calculate_derivative(x, f0, t);
+
+    std::fill(J, J + n * n, 0.0);
+
+    // Perturb all the differential quantities with each color together to
+    // find the corresponding columns of the Jacobian
+    double const sqrt_eps = std::sqrt(std::numeric_limits<double>::epsilon());
+    xp = x;
+
+    for (size_t c = 0; c < n_colors; ++c) {
+        for (size_t j = 0; j < n; ++j) {
+            if (colors[j] == c) {
+                xp[j] = x[j] + sqrt_eps * std::max(std::abs(x[j]), 1.0);
+                h[j] = xp[j] - x[j];  // exactly representable step size
+            }
+        }
+
+        calculate_derivative(xp, f1, t);
+
+        for (size_t j = 0; j < n; ++j) {
+            if (colors[j] == c) {
+                for (size_t i = 0; i < n; ++i) {
+                    if (pattern[i][j]) {
+                        J[position[i] + n * position[j]] = (f1[i] - f0[i]) / h[j];
+                    }
+                }
+                xp[j] = x[j];
+            }
+        }
+    }
+}
+
+void finalize_prepared_system(SEXP system_ptr)
+{
+    delete static_cast<prepared_system*>(R_ExternalPtrAddr(system_ptr));
+    R_ClearExternalPtr(system_ptr);
+}
+
+prepared_system* prepared_system_from_pointer(SEXP system_ptr)
+{
+    prepared_system* ps =
+        static_cast<prepared_system*>(R_ExternalPtrAddr(system_ptr));
+
+    if (!ps) {
+        throw std::runtime_error(
+            "The prepared system is no longer available; it may have been "
+            "saved and restored from a previous R session.");
+    }
+
+    return ps;
+}
+
+/**
+ *  @brief Checks that the values of the differential quantities supplied by the
+ *  solver have the length expected by the prepared system and returns a pointer
+ *  to them.
+ */
+double const* state_from_vector(prepared_system const& ps, SEXP differential_quantities)
+{
+    if (!Rf_isReal(differential_quantities) ||
+        static_cast<size_t>(Rf_length(differential_quantities)) != ps.size()) {
+        throw std::runtime_error(
+            "The differential quantities must be a numeric vector with " +
+            std::to_string(ps.size()) + " elements");
+    }
+
+    return REAL(differential_quantities);
+}
+
+}  // namespace
+
 extern "C" {
 
 /**
  *  @brief Creates a `dynamical_system` object from the differential quantities,
- *         parameters, drivers, and modules, and then uses the system object to
- *         determine the derivatives of the differential quantities at the
- *         specified time
+ *         parameters, drivers, and modules, and stores it in a
+ *         `prepared_system` object, which is returned as an R external pointer
  *
- *  @param [in] differential_quantities An R list of named elements
- *              representing the current values of the differential quantities
+ *  The R external pointer takes ownership of the `prepared_system` object and
+ *  deletes it when the pointer is garbage collected. The R lists of module
+ *  creators are stored in the `prot` field of the pointer so that the module
+ *  creators remain valid for as long as the prepared system exists.
  *
- *  @param [in] time An R numeric vector with one element specifying the time
- *              index
+ *  @param [in] differential_quantities An R list of named elements
+ *              representing the current values of the differential
+ *              quantities. The order of these elements determines the order
+ *              of the values passed to `R_prepared_system_derivatives()` and
+ *              `R_prepared_system_jacobian()`.
  *
  *  @param [in] parameters An R list of named elements representing the
  *              parameters
@@ -32,19 +308,22 @@ extern "C" {
  *  @param [in] direct_mc_vec An R vector of pointers to module wrapper objects
  *              representing the direct modules
  *
- *  @param [in] differential_module_names An R vector of pointers to module
- *              wrapper objects representing the differential modules
+ *  @param [in] differential_mc_vec An R vector of pointers to module wrapper
+ *              objects representing the differential modules
  *
- *  @return An R list of named elements representing the derivatives of the
- *          differential quantities
+ *  @param [in] history_dependent An R logical vector with one element
+ *              indicating whether any of the modules are history-dependent, in
+ *              which case the system is created again before each evaluation
+ *
+ *  @return An R external pointer to a `prepared_system` object
  */
-SEXP R_system_derivatives(
+SEXP R_prepare_system(
     SEXP differential_quantities,
-    SEXP time,
     SEXP parameters,
     SEXP drivers,
     SEXP direct_mc_vec,
-    SEXP differential_mc_vec)
+    SEXP differential_mc_vec,
+    SEXP history_dependent)
 {
     try {
         // Convert the inputs into the proper format
@@ -53,52 +332,121 @@ SEXP R_system_derivatives(
         state_vector_map d = map_vector_from_list(drivers);
 
         if (d.begin()->second.size() == 0) {
-            return R_NilValue;
+            throw std::runtime_error("The drivers must contain at least one time point");
         }
 
         mc_vector direct_mcs = mc_vector_from_list(direct_mc_vec);
         mc_vector differential_mcs = mc_vector_from_list(differential_mc_vec);
 
-        double t = REAL(time)[0];
-
-        // Create a dynamical system
-        dynamical_system sys(iv, p, d, direct_mcs, differential_mcs);
-
-        // Ask the system object for a vector of the current values of the
-        // differential quantities. The system hasn't been modified since its
-        // creation, so these will be the values from the input argument
-        // `differential_quantities`. This step is necessary to ensure they are
-        // arranged in the same order as expected by the system, since it may
-        // reorder them.
-        vector<double> x;
-        sys.get_differential_quantities(x);
-
-        // Get the differential quantity names in the order used by the system,
-        // which may in general be different than the original order of the
-        // quantities in the `differential_quantities` input.
-        string_vector differential_quantity_names =
-            sys.get_differential_quantity_names();
-
-        // Make a vector to store the values of the derivatives of the
-        // differential quantities
-        vector<double> dxdt(x.size());
-
-        // Calculate the derivative (sets dxdt)
-        sys.calculate_derivative(x, dxdt, t);
-
-        // Make the output map
-        state_map result;
-        for (size_t i = 0; i < differential_quantity_names.size(); i++) {
-            result[differential_quantity_names[i]] = dxdt[i];
+        SEXP input_names = Rf_getAttrib(differential_quantities, R_NamesSymbol);
+
+        string_vector names;
+        for (R_xlen_t i = 0; i < Rf_length(input_names); ++i) {
+            names.push_back(CHAR(STRING_ELT(input_names, i)));
         }
 
-        // Return the resulting derivatives
-        return list_from_map(result);
+        std::unique_ptr<prepared_system> ps(new prepared_system(
+            iv, p, d, direct_mcs, differential_mcs, names,
+            LOGICAL(history_dependent)[0]));
+
+        SEXP mc_lists = PROTECT(Rf_allocVector(VECSXP, 2));
+        SET_VECTOR_ELT(mc_lists, 0, direct_mc_vec);
+        SET_VECTOR_ELT(mc_lists, 1, differential_mc_vec);
+
+        SEXP system_ptr =
+            PROTECT(R_MakeExternalPtr(ps.release(), R_NilValue, mc_lists));
+
+        R_RegisterCFinalizerEx(
+            system_ptr,
+            (R_CFinalizer_t)finalize_prepared_system,
+            TRUE);
+
+        UNPROTECT(2);  // UNPROTECT mc_lists and system_ptr
+        return system_ptr;
+
+    } catch (std::exception const& e) {
+        Rf_error((string("Caught exception in R_prepare_system: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_prepare_system.");
+    }
+}
+
+/**
+ *  @brief Uses a prepared system to determine the derivatives of the
+ *         differential quantities at the specified time
+ *
+ *  @param [in] system_ptr An R external pointer produced by
+ *              `R_prepare_system()`
+ *
+ *  @param [in] differential_quantities An R numeric vector of the current
+ *              values of the differential quantities, arranged in the same
+ *              order used to prepare the system
+ *
+ *  @param [in] time An R numeric vector with one element specifying the time
+ *              index
+ *
+ *  @return An R numeric vector of the derivatives of the differential
+ *          quantities, arranged in the same order as `differential_quantities`
+ */
+SEXP R_prepared_system_derivatives(
+    SEXP system_ptr,
+    SEXP differential_quantities,
+    SEXP time)
+{
+    try {
+        prepared_system* ps = prepared_system_from_pointer(system_ptr);
+        double const* x = state_from_vector(*ps, differential_quantities);
+
+        SEXP dxdt = PROTECT(Rf_allocVector(REALSXP, ps->size()));
+
+        ps->derivative(x, REAL(time)[0], REAL(dxdt));
+
+        UNPROTECT(1);  // UNPROTECT dxdt
+        return dxdt;
+
+    } catch (std::exception const& e) {
+        Rf_error((string("Caught exception in R_prepared_system_derivatives: ") + e.what()).c_str());
+    } catch (...) {
+        Rf_error("Caught unhandled exception in R_prepared_system_derivatives.");
+    }
+}
+
+/**
+ *  @brief Uses a prepared system to determine the Jacobian matrix of the
+ *         derivatives of the differential quantities at the specified time
+ *
+ *  The Jacobian is approximated using forward finite differences, where only
+ *  the elements that can be nonzero are calculated; see
+ *  `prepared_system::jacobian()`.
+ *
+ *  The inputs are the same as the inputs to `R_prepared_system_derivatives()`.
+ *
+ *  @return An R numeric matrix `J` where `J[i, j]` is the partial derivative of
+ *          the derivative of the `i`th differential quantity with respect to
+ *          the `j`th differential quantity. Rows and columns are arranged in
+ *          the same order as the quantities in `differential_quantities`.
+ */
+SEXP R_prepared_system_jacobian(
+    SEXP system_ptr,
+    SEXP differential_quantities,
+    SEXP time)
+{
+    try {
+        prepared_system* ps = prepared_system_from_pointer(system_ptr);
+        double const* x = state_from_vector(*ps, differential_quantities);
+
+        size_t const n = ps->size();
+        SEXP jacobian = PROTECT(Rf_allocMatrix(REALSXP, n, n));
+
+        ps->jacobian(x, REAL(time)[0], REAL(jacobian));
+
+        UNPROTECT(1);  // UNPROTECT jacobian
+        return jacobian;
 
     } catch (std::exception const& e) {
-        Rf_error((string("Caught exception in R_system_derivatives: ") + e.what()).c_str());
+        Rf_error((string("Caught exception in R_prepared_system_jacobian: ") + e.what()).c_str());
     } catch (...) {
-        Rf_error("Caught unhandled exception in R_system_derivatives.");
+        Rf_error("Caught unhandled exception in R_prepared_system_jacobian.");
     }
 }
 
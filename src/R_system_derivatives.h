@@ -3,12 +3,22 @@
 
 #include <Rinternals.h>  // for SEXP
 
-extern "C" SEXP R_system_derivatives(
+extern "C" SEXP R_prepare_system(
     SEXP differential_quantities,
-    SEXP time,
     SEXP parameters,
     SEXP drivers,
     SEXP direct_mc_vec,
-    SEXP differential_mc_vec);
+    SEXP differential_mc_vec,
+    SEXP history_dependent);
+
+extern "C" SEXP R_prepared_system_derivatives(
+    SEXP system_ptr,
+    SEXP differential_quantities,
+    SEXP time);
+
+extern "C" SEXP R_prepared_system_jacobian(
+    SEXP system_ptr,
+    SEXP differential_quantities,
+    SEXP time);
 
 #endif
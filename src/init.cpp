@@ -18,6 +18,7 @@
 #include "R_get_all_ode_solvers.h"
 #include "R_module_library.h"
 #include "R_modules.h"
+#include "R_prepared_simulation.h"
 #include "R_run_biocro.h"
 #include "R_system_derivatives.h"
 #include "R_framework_version.h"
@@ -25,13 +26,21 @@
 extern "C" {
 static const R_CallMethodDef callMethods[] = {
     {"R_evaluate_module",                  (DL_FUNC) &R_evaluate_module,                  2},
+    {"R_evaluate_module_batch",            (DL_FUNC) &R_evaluate_module_batch,            4},
     {"R_get_all_modules",                  (DL_FUNC) &R_get_all_modules,                  0},
     {"R_get_all_ode_solvers",              (DL_FUNC) &R_get_all_ode_solvers,              0},
     {"R_get_all_quantities",               (DL_FUNC) &R_get_all_quantities,               0},
     {"R_module_creators",                  (DL_FUNC) &R_module_creators,                  1},
+    {"R_module_history_dependence",        (DL_FUNC) &R_module_history_dependence,        1},
     {"R_module_info",                      (DL_FUNC) &R_module_info,                      2},
-    {"R_run_biocro",                       (DL_FUNC) &R_run_biocro,                       11},
-    {"R_system_derivatives",               (DL_FUNC) &R_system_derivatives,               6},
+    {"R_module_switching_functions",       (DL_FUNC) &R_module_switching_functions,       1},
+    {"R_prepare_simulation",               (DL_FUNC) &R_prepare_simulation,               12},
+    {"R_prepare_system",                   (DL_FUNC) &R_prepare_system,                   6},
+    {"R_prepared_system_derivatives",      (DL_FUNC) &R_prepared_system_derivatives,      3},
+    {"R_prepared_system_jacobian",         (DL_FUNC) &R_prepared_system_jacobian,         3},
+    {"R_run_biocro",                       (DL_FUNC) &R_run_biocro,                       13},
+    {"R_run_biocro_ensemble",              (DL_FUNC) &R_run_biocro_ensemble,              12},
+    {"R_run_prepared_simulation",          (DL_FUNC) &R_run_prepared_simulation,          3},
     {"R_validate_dynamical_system_inputs", (DL_FUNC) &R_validate_dynamical_system_inputs, 6},
     {"R_framework_version",                (DL_FUNC) &R_framework_version,                0},
     {NULL,                                 NULL,                                          0}
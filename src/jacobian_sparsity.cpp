@@ -0,0 +1,177 @@
+#include <string>
+#include <unordered_map>
+#include "jacobian_sparsity.h"
+
+using std::string;
+using std::vector;
+
+/**
+ *  @brief Determines which elements of the Jacobian matrix of a dynamical
+ *  system can be nonzero, using only the inputs and outputs declared by its
+ *  modules.
+ *
+ *  Each differential quantity depends on itself. The outputs of a direct
+ *  module depend on every differential quantity that any of its inputs depends
+ *  on, and the derivative of a differential quantity depends on every
+ *  differential quantity that the inputs of the differential modules that
+ *  calculate it depend on. Since the direct modules may not be supplied in the
+ *  order in which they are run, their dependencies are propagated repeatedly
+ *  until nothing changes; a valid system has no cycles, so this always
+ *  terminates.
+ *
+ *  @param [in] differential_quantity_names The names of the differential
+ *              quantities, which determine the order of the rows and columns
+ *
+ *  @param [in] direct_mcs The direct module creators used by the system
+ *
+ *  @param [in] differential_mcs The differential module creators used by the
+ *              system
+ *
+ *  @return A sparsity pattern where element `[i, j]` is `true` when the
+ *          derivative of the `i`th differential quantity may depend on the
+ *          `j`th differential quantity
+ */
+sparsity_pattern jacobian_sparsity(
+    string_vector const& differential_quantity_names,
+    mc_vector const& direct_mcs,
+    mc_vector const& differential_mcs)
+{
+    size_t const n = differential_quantity_names.size();
+
+    // For each quantity, a list of flags indicating the differential
+    // quantities it depends on; quantities without an entry (such as
+    // parameters and drivers) do not depend on any of them
+    std::unordered_map<string, vector<bool>> dependencies;
+    std::unordered_map<string, size_t> position;
+
+    for (size_t i = 0; i < n; ++i) {
+        dependencies[differential_quantity_names[i]] = vector<bool>(n, false);
+        dependencies[differential_quantity_names[i]][i] = true;
+        position[differential_quantity_names[i]] = i;
+    }
+
+    // Adds the dependencies of the `inputs` to `deps`, returning true if any
+    // new dependencies were added
+    auto add_input_dependencies = [&dependencies, n](
+                                      string_vector const& inputs,
+                                      vector<bool>& deps) {
+        bool changed = false;
+        for (string const& name : inputs) {
+            auto it = dependencies.find(name);
+            if (it != dependencies.end()) {
+                for (size_t j = 0; j < n; ++j) {
+                    if (it->second[j] && !deps[j]) {
+                        deps[j] = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        return changed;
+    };
+
+    // Propagate dependencies through the direct modules
+    vector<string_vector> direct_inputs;
+    vector<string_vector> direct_outputs;
+    for (module_creator* mc : direct_mcs) {
+        direct_inputs.push_back(mc->get_inputs());
+        direct_outputs.push_back(mc->get_outputs());
+    }
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t k = 0; k < direct_mcs.size(); ++k) {
+            vector<bool> deps(n, false);
+            add_input_dependencies(direct_inputs[k], deps);
+
+            for (string const& output : direct_outputs[k]) {
+                auto it = dependencies.find(output);
+                if (it == dependencies.end()) {
+                    it = dependencies.emplace(output, vector<bool>(n, false)).first;
+                }
+                for (size_t j = 0; j < n; ++j) {
+                    if (deps[j] && !it->second[j]) {
+                        it->second[j] = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Each differential module contributes to the derivatives of its outputs
+    sparsity_pattern pattern(n, vector<bool>(n, false));
+
+    for (module_creator* mc : differential_mcs) {
+        vector<bool> deps(n, false);
+        add_input_dependencies(mc->get_inputs(), deps);
+
+        for (string const& output : mc->get_outputs()) {
+            auto it = position.find(output);
+            if (it != position.end()) {
+                for (size_t j = 0; j < n; ++j) {
+                    if (deps[j]) {
+                        pattern[it->second][j] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return pattern;
+}
+
+/**
+ *  @brief Partitions the columns of a Jacobian matrix into groups that can be
+ *  approximated together using finite differences.
+ *
+ *  Two columns can be in the same group when no row has a possibly-nonzero
+ *  element in both of them, since perturbing both quantities at once then
+ *  changes each derivative through at most one of them. The columns are
+ *  assigned colors greedily, in order, using the smallest color that does not
+ *  conflict with any column already assigned to it.
+ *
+ *  @param [in] pattern A sparsity pattern, as returned by `jacobian_sparsity()`
+ *
+ *  @return The color of each column; the number of colors (one more than the
+ *          largest color) is the number of derivative evaluations needed to
+ *          approximate the Jacobian
+ */
+vector<size_t> color_jacobian_columns(sparsity_pattern const& pattern)
+{
+    size_t const n = pattern.size();
+
+    vector<size_t> colors(n, 0);
+
+    // For each color, the rows that have a possibly-nonzero element in at
+    // least one of the columns with that color
+    vector<vector<bool>> rows_used_by_color;
+
+    for (size_t j = 0; j < n; ++j) {
+        size_t c = 0;
+        for (; c < rows_used_by_color.size(); ++c) {
+            bool conflict = false;
+            for (size_t i = 0; i < n && !conflict; ++i) {
+                conflict = pattern[i][j] && rows_used_by_color[c][i];
+            }
+            if (!conflict) {
+                break;
+            }
+        }
+
+        if (c == rows_used_by_color.size()) {
+            rows_used_by_color.emplace_back(n, false);
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            if (pattern[i][j]) {
+                rows_used_by_color[c][i] = true;
+            }
+        }
+
+        colors[j] = c;
+    }
+
+    return colors;
+}
@@ -0,0 +1,19 @@
+#ifndef JACOBIAN_SPARSITY_H
+#define JACOBIAN_SPARSITY_H
+
+#include <vector>
+#include "framework/module_creator.h"  // for mc_vector
+#include "framework/state_map.h"       // for string_vector
+
+// A boolean matrix stored by rows, where `pattern[i][j]` indicates whether
+// element `[i, j]` of a Jacobian matrix can be nonzero
+using sparsity_pattern = std::vector<std::vector<bool>>;
+
+sparsity_pattern jacobian_sparsity(
+    string_vector const& differential_quantity_names,
+    mc_vector const& direct_mcs,
+    mc_vector const& differential_mcs);
+
+std::vector<size_t> color_jacobian_columns(sparsity_pattern const& pattern);
+
+#endif
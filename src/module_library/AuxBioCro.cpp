@@ -8,8 +8,7 @@
 #include <cmath>      // for exp, log, pow, lgamma
 #include "c4photo.h"
 #include "BioCro.h"
-#include "water_and_air_properties.h"  // for saturation_vapor_pressure,
-                                       // TempToDdryA, TempToLHV, TempToSFS
+#include "water_and_air_properties.h"  // for TempToDdryA, TempToLHV, TempToSFS
 #include "sunML.h"                     // for thick_layer_absorption
 #include "../framework/constants.h"    // for pi, e, ideal_gas_constant,
                                        // atmospheric_pressure_at_sea_level,
@@ -59,7 +58,7 @@ double poisson_density(int x, double lambda)
  * Preconditions:
  *     `WindSpeed` is non-negative.
  *     `LAI` is non-negative
- *     `nlayers` is at least 1 and at most MAXLAY.
+ *     `nlayers` is at least 1.
  *     `wind_speed_profile` is an array of at least size `nlayers`.
  */
 void WINDprof(double WindSpeed, double LAI, int nlayers, double* wind_speed_profile)
@@ -79,7 +78,7 @@ void WINDprof(double WindSpeed, double LAI, int nlayers, double* wind_speed_prof
  *
  * @param[in] RH relative humidity just above the canopy `(0 <= RH <= 1)`
  *
- * @param[in] nlayers number of layers in the canopy `(1 <= nlayers <= MAXLAY)`
+ * @param[in] nlayers number of layers in the canopy `(1 <= nlayers)`
  *
  * @param[out] relative_humidity_profile array of relative humidity values
  * expressed as fractions between 0 and 1, where the value at index `i`
@@ -166,8 +165,8 @@ void RHprof(double RH, int nlayers, double* relative_humidity_profile)
     if (RH > 1 || RH < 0) {
         throw std::out_of_range("RH must be between 0 and 1.");
     }
-    if (nlayers < 1 || nlayers > MAXLAY) {
-        throw std::out_of_range("nlayers must be at least 1 but no more than MAXLAY.");
+    if (nlayers < 1) {
+        throw std::out_of_range("nlayers must be at least 1.");
     }
 
     const double kh = 1 - RH;
@@ -198,13 +197,14 @@ ET_Str EvapoTrans2(
     double leaf_width,                       // meter
     double specific_heat_of_air,             // J / kg / K
     double minimum_gbw,                      // mol / m^2 / s
-    int eteq                                 // unitless parameter
+    int eteq,                                // unitless parameter
+    saturation_vapor_pressure_function swvp  // Pa from degrees C
 )
 {
     const double DdryA = TempToDdryA(airTemp);               // kg / m^3. Density of dry air.,
     const double LHV = TempToLHV(airTemp);                   // J / kg
     const double SlopeFS = TempToSFS(airTemp);               // kg / m^3 / K
-    const double SWVP = saturation_vapor_pressure(airTemp);  // Pa.
+    const double SWVP = swvp(airTemp);                       // Pa.
 
     // TODO: This is for about 20 degrees C at 100000 Pa. Change it to use the
     // model state. (1 * R * temperature) / pressure
@@ -248,7 +248,7 @@ ET_Str EvapoTrans2(
         do {
             ga = leaf_boundary_layer_conductance_nikolov(
                 WindSpeed, leaf_width, airTemp, Deltat, conductance_in_m_per_s,
-                ActualVaporPressure, minimum_gbw_in_m_per_s);  // m / s
+                ActualVaporPressure, minimum_gbw_in_m_per_s, swvp);  // m / s
 
             /* In WIMOVAC, ga was added to the canopy conductance */
             /* ga = (ga * gbcW)/(ga + gbcW); */
@@ -378,16 +378,20 @@ ET_Str EvapoTrans2(
  *  @param [in] minimum_gbw The lowest possible value for boundary layer
  *              conductance in m / s that should be returned
  *
+ *  @param [in] swvp The function used to calculate saturation water vapor
+ *              pressure at the leaf temperature
+ *
  *  @return The boundary layer conductance in m / s
  */
 double leaf_boundary_layer_conductance_nikolov(
-    double windspeed,             // m / s
-    double leafwidth,             // m
-    double air_temperature,       // degrees C
-    double delta_t,               // degrees C
-    double stomcond,              // m / s
-    double water_vapor_pressure,  // Pa
-    double minimum_gbw            // m / s
+    double windspeed,                        // m / s
+    double leafwidth,                        // m
+    double air_temperature,                  // degrees C
+    double delta_t,                          // degrees C
+    double stomcond,                         // m / s
+    double water_vapor_pressure,             // Pa
+    double minimum_gbw,                      // m / s
+    saturation_vapor_pressure_function swvp  // Pa from degrees C
 )
 {
     constexpr double p = physical_constants::atmospheric_pressure_at_sea_level;  // Pa
@@ -399,7 +403,7 @@ double leaf_boundary_layer_conductance_nikolov(
     double ea = water_vapor_pressure;                                        // Pa
     double lw = leafwidth;                                                   // m
 
-    double esTl = saturation_vapor_pressure(leaftemp);  // Pa.
+    double esTl = swvp(leaftemp);  // Pa.
 
     // Forced convection
     constexpr double cf = 1.6361e-3;  // TODO: Nikolov et. al equation 29 use cf = 4.322e-3, not cf = 1.6e-3 as is used here.
@@ -536,7 +540,8 @@ double SoilEvapo(
     double soil_reflectance,
     double soil_transmission,
     double specific_heat_of_air,
-    double par_energy_content)
+    double par_energy_content,
+    saturation_vapor_pressure_function swvp)
 {
     int method = 1;
 
@@ -574,7 +579,7 @@ double SoilEvapo(
     double DdryA = TempToDdryA(air_temperature);
     double LHV = TempToLHV(air_temperature);  // J / kg
     double SlopeFS = TempToSFS(air_temperature);
-    double SWVC = saturation_vapor_pressure(air_temperature) * 1e-5;
+    double SWVC = swvp(air_temperature) * 1e-5;
 
     double PsycParam = (DdryA * specific_heat_of_air) / LHV;
     double vapor_density_deficit = SWVC * (1 - RelH / 100);
@@ -737,8 +742,9 @@ ws_str watstr(
 
 /* Function to simulate the multilayer behavior of soil water. In the
    future this could be coupled with Campbell (BASIC) ideas to
-   esitmate water potential. */
-soilML_str soilML(
+   esitmate water potential. The results are stored in `soil_profile`, whose
+   vectors are resized to `layers` if necessary. */
+void soilML(
     double precipit,
     double transp,
     double* cws,
@@ -770,16 +776,20 @@ soilML_str soilML(
     double soil_reflectance,
     double soil_transmission,
     double specific_heat_of_air,
-    double par_energy_content)
+    double par_energy_content,
+    soilML_str& soil_profile)
 {
     constexpr double g = 9.8; /* m / s-2  ##  http://en.wikipedia.org/wiki/Standard_gravity */
 
-    soilML_str return_value;
+    soil_profile.cws.resize(layers);
+    soil_profile.rootDist.resize(layers);
 
     /* Crude empirical relationship between root biomass and rooting depth*/
     double rootDepth = fmin(rootDB * rsdf, soildepth);
 
-    rd_str root_distribution = rootDist(layers, rootDepth, &depths[0], rfl);
+    /* The root fractions are stored in `soil_profile.rootDist` and replaced
+       by the root biomass in each layer as the layers are processed below */
+    rootDist(layers, rootDepth, &depths[0], rfl, soil_profile.rootDist.data());
 
     /* unit conversion for precip */
     double oldWaterIn = 0.0;
@@ -854,8 +864,9 @@ soilML_str soilML(
         }
 
         /* Root Biomass */
-        double rootATdepth = rootDB * root_distribution.rootDist[i];
-        return_value.rootDist[i] = rootATdepth;
+        double root_fraction = soil_profile.rootDist[i];
+        double rootATdepth = rootDB * root_fraction;
+        soil_profile.rootDist[i] = rootATdepth;
         /* Plant available water is only between current water status and permanent wilting point */
         /* Plant available water */
         double pawha = (aw - soil_wilting_point * layerDepth) * 1e4;
@@ -879,14 +890,14 @@ soilML_str soilML(
             /* I assume that crop transpiration is distributed simlarly to
                root density.  In other words the crop takes up water proportionally
                to the amount of root in each respective layer.*/
-            Ctransp = transp * root_distribution.rootDist[0];
+            Ctransp = transp * root_fraction;
             EvapoTra = Ctransp + Sevap;
             constexpr double density_of_water_at_20_celcius = 0.9982;  // Mg m^-3.
             Newpawha = pawha - EvapoTra / density_of_water_at_20_celcius;
             /* The first term in the rhs pawha is the m3 of water available in this layer.
                EvapoTra is the Mg H2O ha-1 of transpired and evaporated water. 1/0.9882 converts from Mg to m3 */
         } else {
-            Ctransp = transp * root_distribution.rootDist[i];
+            Ctransp = transp * root_fraction;
             EvapoTra = Ctransp;
             Newpawha = pawha - (EvapoTra + oldEvapoTra);
         }
@@ -900,7 +911,7 @@ soilML_str soilML(
         double awc = Newpawha / 1e4 / layerDepth + soil_wilting_point;
 
         /* This might look like a weird place to populate the structure, but is more convenient*/
-        return_value.cws[i] = awc;
+        soil_profile.cws[i] = awc;
 
         // To-do: Replace this block with a call to compute_wsPhoto.
         /* three different type of equations for modeling the effect of water stress on vmax and leaf area expansion.
@@ -942,17 +953,15 @@ soilML_str soilML(
         drainage = waterIn;
         /* Need to convert to units used in the Parton et al 1988 paper. */
         /* The data comes in mm/hr and it needs to be in cm/month */
-        return_value.Nleach = drainage * 0.1 * (1 / 24 * 30) / (1e3 * physical_constants::molar_mass_of_water * (0.2 + 0.7 * soil_sand_content));
+        soil_profile.Nleach = drainage * 0.1 * (1 / 24 * 30) / (1e3 * physical_constants::molar_mass_of_water * (0.2 + 0.7 * soil_sand_content));
     } else {
-        return_value.Nleach = 0.0;
+        soil_profile.Nleach = 0.0;
     }
 
-    return_value.rcoefPhoto = (wsPhotoCol / layers);
-    return_value.drainage = drainage;
-    return_value.rcoefSpleaf = (LeafWSCol / layers);
-    return_value.SoilEvapo = Sevap;
-
-    return return_value;
+    soil_profile.rcoefPhoto = (wsPhotoCol / layers);
+    soil_profile.drainage = drainage;
+    soil_profile.rcoefSpleaf = (LeafWSCol / layers);
+    soil_profile.SoilEvapo = Sevap;
 }
 
 /**
@@ -1062,32 +1071,20 @@ double resp(double base_rate, double mrc, double temp)
     return ans;
 }
 
-seqRD_str seqRootDepth(double to, int lengthOut)
-{
-    double by = to / lengthOut;
-
-    seqRD_str result;
-    for (int i = 0; i <= lengthOut; ++i) {
-        result.rootDepths[i] = i * by;
-    }
-    return result;
-}
-
-rd_str rootDist(int n_layers, double rootDepth, double* depths, double rfl)
+void rootDist(int n_layers, double rootDepth, double* depths, double rfl, double* root_distribution)
 {
     /*
      * Calculate the fraction of total root mass for each layer in `depths` assuming the mass
      * is follows a Poisson distribution along the depth.
      *
-     * Returns a struct with one array of size `n_layers`.
-     * Each element in the array is the fraction of total root mass in that layer.
-     * The sum of all elements of the result equals 1.
+     * The fractions are stored in `root_distribution`, which must have at least `n_layers` elements.
+     * Each element is the fraction of total root mass in that layer.
+     * The sum of the first `n_layers` elements equals 1.
      */
 
     double layerDepth = 0.0;
     double CumLayerDepth = 0.0;
     int CumRootDist = 1;
-    double rootDist[n_layers];
     double cumulative_a = 0.0;
 
     for (int i = 0; i < n_layers; ++i) {
@@ -1107,16 +1104,14 @@ rd_str rootDist(int n_layers, double rootDepth, double* depths, double rfl)
     for (int j = 0; j < n_layers; ++j) {
         if (j < CumRootDist) {
             double a = poisson_density(j + 1, (double)CumRootDist * rfl);
-            rootDist[j] = a;
+            root_distribution[j] = a;
             cumulative_a += a;
         } else {
-            rootDist[j] = 0;
+            root_distribution[j] = 0;
         }
     }
 
-    rd_str result;
     for (int k = 0; k < n_layers; ++k) {
-        result.rootDist[k] = rootDist[k] / cumulative_a;
+        root_distribution[k] /= cumulative_a;
     }
-    return result;
 }
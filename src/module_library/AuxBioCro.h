@@ -2,15 +2,15 @@
 #define AUXBIOCRO_H
 
 #include <map>
+#include <vector>
 #include "../framework/constants.h" // for ideal_gas_constant
+#include "water_and_air_properties.h" // for saturation_vapor_pressure_function
 
 /* This file will contain functions which are common to several */
 /* routines in the BioCro package. These are functions needed */
 /* internally. The normal user will not need them */
 
 
-#define MAXLAY    200 /* Maximum number of layers */
-
 struct ET_Str {
   double TransR;
   double EPenman;
@@ -26,14 +26,18 @@ struct ws_str {
   double Nleach;
 };
 
+// The `cws` and `rootDist` vectors are resized to the number of soil layers by
+// `soilML`, so the same object can be reused for many calls.
 struct soilML_str {
+  explicit soilML_str(int layers = 0) : cws(layers), rootDist(layers) {}
+
   double rcoefPhoto;
   double rcoefSpleaf;
-  double cws[MAXLAY];
+  std::vector<double> cws;
   double drainage;
   double Nleach;
   double SoilEvapo;
-  double rootDist[MAXLAY];
+  std::vector<double> rootDist;
 };
 
 
@@ -46,17 +50,7 @@ struct dbp_str{
 
 };
 
-struct seqRD_str{
-  double rootDepths[MAXLAY+1];
-};
-
-seqRD_str seqRootDepth(double to, int lengthOut);
-
-struct rd_str{
-  double rootDist[MAXLAY];
-};
-
-rd_str rootDist(int layer, double rootDepth, double *depths, double rfl);
+void rootDist(int layer, double rootDepth, double *depths, double rfl, double *root_distribution);
 
 struct frostParms {
   double leafT0;
@@ -104,7 +98,8 @@ double leaf_boundary_layer_conductance_nikolov(
     double delta_t,
     double stomcond,
     double water_vapor_pressure,
-    double minimum_gbw
+    double minimum_gbw,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure
 );
 
 double leaf_boundary_layer_conductance_thornley(
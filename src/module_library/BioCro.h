@@ -15,15 +15,16 @@ double SoilEvapo(
     double soil_water_content, double fieldc, double wiltp, double winds,
     double RelH, double rsec, double soil_clod_size, double soil_reflectance,
     double soil_transmission, double specific_heat_of_air,
-    double par_energy_content);
+    double par_energy_content,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure);
 
-soilML_str soilML(double precipit, double transp, double *cws, double soildepth, double *depths,
+void soilML(double precipit, double transp, double *cws, double soildepth, double *depths,
         double soil_field_capacity, double soil_wilting_point, double soil_saturation_capacity, double soil_air_entry, double soil_saturated_conductivity,
         double soil_b_coefficient, double soil_sand_content, double phi1, double phi2, int wsFun,
         int layers, double rootDB, double LAI, double k, double AirTemp,
         double IRad, double winds, double RelH, int hydrDist, double rfl,
         double rsec, double rsdf, double soil_clod_size, double soil_reflectance, double soil_transmission,
-        double specific_heat_of_air, double par_energy_content);
+        double specific_heat_of_air, double par_energy_content, soilML_str &soil_profile);
 
 void RHprof(double RH, int nlayers, double* relative_humidity_profile);
 void WINDprof(double WindSpeed, double LAI, int nlayers, double* wind_speed_profile);
@@ -40,7 +41,8 @@ ET_Str EvapoTrans2(
     double leaf_width,
     double specific_heat_of_air,
     double minimum_gbw,
-    int eteq
+    int eteq,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure
 );
 
 ET_Str c3EvapoTrans(
@@ -52,7 +54,8 @@ ET_Str c3EvapoTrans(
     double specific_heat_of_air,
     double stomatal_conductance,
     double minimum_gbw,
-    double WindSpeedHeight
+    double WindSpeedHeight,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure
 );
 
 #endif
@@ -1,3 +1,4 @@
+#include <vector>
 #include "CanAC.h"
 #include "BioCro.h"                  // for WINDprof, EvapoTrans2
 #include "c4photo.h"                 // for c4photoC
@@ -31,19 +32,21 @@ canopy_photosynthesis_outputs CanAC(
     double upperT,  // degrees C
     double lowerT,  // degrees C
     const nitroParms& nitroP,
-    double leafwidth,                  // m
-    int eteq,                          // dimensionless switch
-    double StomataWS,                  // dimensionless
-    double specific_heat_of_air,       // J / kg / K
-    double atmospheric_pressure,       // Pa
-    double atmospheric_transmittance,  // dimensionless
-    double atmospheric_scattering,     // dimensionless
-    double absorptivity_par,           // dimensionless
-    double par_energy_content,         // J / micromol
-    double par_energy_fraction,        // dimensionless
-    double leaf_transmittance,         // dimensionless
-    double leaf_reflectance,           // dimensionless
-    double minimum_gbw                 // mol / m^2 / s
+    double leafwidth,                        // m
+    int eteq,                                // dimensionless switch
+    double StomataWS,                        // dimensionless
+    double specific_heat_of_air,             // J / kg / K
+    double atmospheric_pressure,             // Pa
+    double atmospheric_transmittance,        // dimensionless
+    double atmospheric_scattering,           // dimensionless
+    double absorptivity_par,                 // dimensionless
+    double par_energy_content,               // J / micromol
+    double par_energy_fraction,              // dimensionless
+    double leaf_transmittance,               // dimensionless
+    double leaf_reflectance,                 // dimensionless
+    double minimum_gbw,                      // mol / m^2 / s
+    canopy_profile_buffers& buffers,         // storage for the canopy profiles
+    saturation_vapor_pressure_function swvp  // Pa from degrees C
 )
 {
     Light_model light_model = lightME(
@@ -59,18 +62,20 @@ canopy_photosynthesis_outputs CanAC(
 
     // Here we set `heightf = 1`. The value used for `heightf` does not matter,
     // since the canopy height is not used anywhere in this function.
-    Light_profile light_profile =
-        sunML(q_dir, q_diff, LAI, nlayers, cosine_zenith_angle, kd, chil, absorptivity_par,
-              1, par_energy_content, par_energy_fraction,
-              leaf_transmittance, leaf_reflectance);
+    buffers.resize(nlayers);
+
+    Light_profile& light_profile = buffers.light_profile;
+    sunML(q_dir, q_diff, LAI, nlayers, cosine_zenith_angle, kd, chil, absorptivity_par,
+          1, par_energy_content, par_energy_fraction,
+          leaf_transmittance, leaf_reflectance, light_profile);
 
     double LAIc = LAI / nlayers;  // dimensionless
 
-    double wind_speed_profile[nlayers];
-    WINDprof(WindSpeed, LAI, nlayers, wind_speed_profile);  // Modifies wind_speed_profile
+    std::vector<double>& wind_speed_profile = buffers.wind_speed_profile;
+    WINDprof(WindSpeed, LAI, nlayers, wind_speed_profile.data());  // Modifies wind_speed_profile
 
-    double leafN_profile[nlayers];
-    LNprof(leafN, LAI, nlayers, kpLN, leafN_profile);  // Modifies leafN_profile
+    std::vector<double>& leafN_profile = buffers.leafN_profile;
+    LNprof(leafN, LAI, nlayers, kpLN, leafN_profile.data());  // Modifies leafN_profile
 
     double CanopyA{0.0};             // micromol / m^2 / s
     double GCanopyA{0.0};            // micromol / m^2 / s
@@ -121,14 +126,14 @@ canopy_photosynthesis_outputs CanAC(
                 RH, vmax1, Alpha, Kparm,
                 theta, beta, Rd, b0, b1, Gs_min, StomataWS, Catm,
                 atmospheric_pressure, upperT, lowerT,
-                gbw_guess)
+                gbw_guess, swvp)
                 .Gs;  // mmol / m^2 / s
 
         ET_Str et_direct =
             EvapoTrans2(
                 j_dir, j_avg, ambient_temperature, RH, layer_wind_speed,
                 direct_gsw_estimate, leafwidth, specific_heat_of_air,
-                minimum_gbw, eteq);
+                minimum_gbw, eteq, swvp);
 
         double leaf_temperature_dir = ambient_temperature + et_direct.Deltat;  // degrees C
 
@@ -138,7 +143,7 @@ canopy_photosynthesis_outputs CanAC(
                 RH, vmax1, Alpha, Kparm,
                 theta, beta, Rd, b0, b1, Gs_min, StomataWS, Catm,
                 atmospheric_pressure, upperT, lowerT,
-                et_direct.boundary_layer_conductance);
+                et_direct.boundary_layer_conductance, swvp);
 
         // Calculations for shaded leaves. First, estimate stomatal conductance
         // by assuming the leaf has the same temperature as the air. Then, use
@@ -156,14 +161,14 @@ canopy_photosynthesis_outputs CanAC(
                 RH, vmax1, Alpha, Kparm,
                 theta, beta, Rd, b0, b1, Gs_min, StomataWS, Catm,
                 atmospheric_pressure, upperT, lowerT,
-                gbw_guess)
+                gbw_guess, swvp)
                 .Gs;  // mmol / m^2 / s
 
         ET_Str et_diffuse =
             EvapoTrans2(
                 j_diff, j_avg, ambient_temperature, RH, layer_wind_speed,
                 diffuse_gsw_estimate, leafwidth, specific_heat_of_air,
-                minimum_gbw, eteq);
+                minimum_gbw, eteq, swvp);
 
         double leaf_temperature_diff = ambient_temperature + et_diffuse.Deltat;  // degrees C
 
@@ -173,7 +178,7 @@ canopy_photosynthesis_outputs CanAC(
                 RH, vmax1, Alpha, Kparm,
                 theta, beta, Rd, b0, b1, Gs_min, StomataWS, Catm,
                 atmospheric_pressure, upperT, lowerT,
-                et_diffuse.boundary_layer_conductance);
+                et_diffuse.boundary_layer_conductance, swvp);
 
         // Combine sunlit and shaded leaves
         CanopyA += Leafsun * direct_photo.Assim + Leafshade * diffuse_photo.Assim;             // micromol / m^2 / s
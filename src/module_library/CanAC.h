@@ -3,6 +3,8 @@
 
 #include "AuxBioCro.h"                      // for nitroParms
 #include "canopy_photosynthesis_outputs.h"  // for canopy_photosynthesis_outputs
+#include "canopy_profile_buffers.h"         // for canopy_profile_buffers
+#include "water_and_air_properties.h"       // for saturation_vapor_pressure_function
 
 canopy_photosynthesis_outputs CanAC(
     double LAI,
@@ -42,6 +44,8 @@ canopy_photosynthesis_outputs CanAC(
     double par_energy_fraction,
     double leaf_transmittance,
     double leaf_reflectance,
-    double minimum_gbw);
+    double minimum_gbw,
+    canopy_profile_buffers& buffers,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure);
 
 #endif
@@ -16,7 +16,10 @@ namespace standardBML
 class ball_berry : public direct_module
 {
    public:
-    ball_berry(state_map const& input_quantities, state_map* output_quantities)
+    ball_berry(
+        state_map const& input_quantities,
+        state_map* output_quantities,
+        saturation_vapor_pressure_function swvp = saturation_vapor_pressure)
         : direct_module{},
 
           // Get pointers to input quantities
@@ -32,7 +35,9 @@ class ball_berry : public direct_module
           // Get pointers to output quantities
           cs_op{get_op(output_quantities, "cs")},
           hs_op{get_op(output_quantities, "hs")},
-          leaf_stomatal_conductance_op{get_op(output_quantities, "leaf_stomatal_conductance")}
+          leaf_stomatal_conductance_op{get_op(output_quantities, "leaf_stomatal_conductance")},
+
+          swvp{swvp}
     {
     }
     static string_vector get_inputs();
@@ -55,6 +60,9 @@ class ball_berry : public direct_module
     double* hs_op;
     double* leaf_stomatal_conductance_op;
 
+    // Function used to calculate saturation water vapor pressure
+    saturation_vapor_pressure_function const swvp;
+
     // Main operation
     void do_operation() const;
 };
@@ -92,12 +100,35 @@ void ball_berry::do_operation() const
         b1,
         gbw,
         leaf_temperature,
-        ambient_air_temperature);
+        ambient_air_temperature,
+        swvp);
 
     update(cs_op, result.cs);
     update(hs_op, result.hs);
     update(leaf_stomatal_conductance_op, result.gsw);
 }
 
+/**
+ * @class ball_berry_tabulated_swvp
+ *
+ * @brief Identical to `ball_berry`, except that saturation water vapor
+ * pressure is calculated by `saturation_vapor_pressure_tabulated()` rather
+ * than `saturation_vapor_pressure()`.
+ */
+class ball_berry_tabulated_swvp : public ball_berry
+{
+   public:
+    ball_berry_tabulated_swvp(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : ball_berry{
+              input_quantities,
+              output_quantities,
+              saturation_vapor_pressure_tabulated}
+    {
+    }
+    static std::string get_name() { return "ball_berry_tabulated_swvp"; }
+};
+
 }  // namespace standardBML
 #endif
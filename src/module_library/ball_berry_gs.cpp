@@ -3,7 +3,6 @@
 #include "ball_berry_gs.h"
 #include "../framework/constants.h"       // for dr_boundary
 #include "../framework/quadratic_root.h"  // for quadratic_root_plus
-#include "water_and_air_properties.h"     // for saturation_vapor_pressure
 
 using calculation_constants::eps_zero;
 using physical_constants::dr_boundary;
@@ -91,18 +90,22 @@ using physical_constants::dr_boundary;
  *
  *  @param [in] ambient_air_temperature \f$ T_a \f$ in units of degrees C.
  *
+ *  @param [in] swvp The function used to calculate saturation water vapor
+ *              pressure at \f$ T_a \f$ and \f$ T_l \f$.
+ *
  *  @return Stomatal conductance to water vapor diffusion \f$ g_{sw} \f$ in
  *          units of mmol / m^2 / s
  */
 stomata_outputs ball_berry_gs(
-    double assimilation,            // mol / m^2 / s
-    double ambient_c,               // mol / mol
-    double ambient_rh,              // Pa / Pa
-    double bb_offset,               // mol / m^2 / s
-    double bb_slope,                // dimensionless from [mol / m^2 / s] / [mol / m^2 / s]
-    double gbw,                     // mol / m^2 / s
-    double leaf_temperature,        // degrees C
-    double ambient_air_temperature  // degrees C
+    double assimilation,                     // mol / m^2 / s
+    double ambient_c,                        // mol / mol
+    double ambient_rh,                       // Pa / Pa
+    double bb_offset,                        // mol / m^2 / s
+    double bb_slope,                         // dimensionless from [mol / m^2 / s] / [mol / m^2 / s]
+    double gbw,                              // mol / m^2 / s
+    double leaf_temperature,                 // degrees C
+    double ambient_air_temperature,          // degrees C
+    saturation_vapor_pressure_function swvp  // Pa from degrees C
 )
 {
     // If An < 0, set b1 = 0 to ensure that gsw = b0 in Equation (1) as defined
@@ -123,8 +126,8 @@ stomata_outputs ball_berry_gs(
     const double acs = assimilation / Cs;  // mol / m^2 / s
 
     const double swvp_ratio =
-        saturation_vapor_pressure(ambient_air_temperature) /
-        saturation_vapor_pressure(leaf_temperature);  // dimensionless
+        swvp(ambient_air_temperature) /
+        swvp(leaf_temperature);  // dimensionless
 
     // Calculate hs using Equation (3) as defined above
     const double a = bb_slope * acs;                              // mol / m^2 / s
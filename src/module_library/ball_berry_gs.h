@@ -1,7 +1,8 @@
 #ifndef BALL_BERRY_GS_H
 #define BALL_BERRY_GS_H
 
-#include "stomata_outputs.h"
+#include "stomata_outputs.h"            // for stomata_outputs
+#include "water_and_air_properties.h"  // for saturation_vapor_pressure_function
 
 stomata_outputs ball_berry_gs(
     double assimilation,
@@ -11,6 +12,7 @@ stomata_outputs ball_berry_gs(
     double bb_slope,
     double gbw,
     double leaf_temperature,
-    double ambient_air_temperature);
+    double ambient_air_temperature,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure);
 
 #endif
@@ -0,0 +1,75 @@
+#ifndef BUCK_SWVP_TABULATED_H
+#define BUCK_SWVP_TABULATED_H
+
+#include "../framework/module.h"
+#include "../framework/state_map.h"
+#include "water_and_air_properties.h"  // for saturation_vapor_pressure_tabulated
+
+namespace standardBML
+{
+/**
+ * @class buck_swvp_tabulated
+ *
+ * @brief Determines the saturation water vapor pressure of atmospheric air
+ * using the `saturation_vapor_pressure_tabulated()` function, which
+ * approximates the Arden Buck equation using a table of cubic polynomials.
+ *
+ * The result differs from that of the `buck_swvp` module by a relative error
+ * of less than 1e-8 for temperatures between -40 and 60 degrees C, and it is
+ * identical outside that range. Using this module or `buck_swvp` is a choice
+ * made separately for each simulation, so simulations that must reproduce
+ * earlier results exactly can continue to use `buck_swvp`.
+ */
+class buck_swvp_tabulated : public direct_module
+{
+   public:
+    buck_swvp_tabulated(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : direct_module{},
+
+          // Get references to input quantities
+          temp{get_input(input_quantities, "temp")},
+
+          // Get pointers to output quantities
+          saturation_water_vapor_pressure_atmosphere_op{get_op(output_quantities, "saturation_water_vapor_pressure_atmosphere")}
+    {
+    }
+    static string_vector get_inputs();
+    static string_vector get_outputs();
+    static std::string get_name() { return "buck_swvp_tabulated"; }
+
+   private:
+    // References to input quantities
+    double const& temp;
+
+    // Pointers to output quantities
+    double* saturation_water_vapor_pressure_atmosphere_op;
+
+    // Main operation
+    void do_operation() const;
+};
+
+string_vector buck_swvp_tabulated::get_inputs()
+{
+    return {
+        "temp"  // degrees C
+    };
+}
+
+string_vector buck_swvp_tabulated::get_outputs()
+{
+    return {
+        "saturation_water_vapor_pressure_atmosphere"  // Pa
+    };
+}
+
+void buck_swvp_tabulated::do_operation() const
+{
+    // Update the output quantity list
+    update(saturation_water_vapor_pressure_atmosphere_op,
+           saturation_vapor_pressure_tabulated(temp));  // Pa
+}
+
+}  // namespace standardBML
+#endif
@@ -1,3 +1,4 @@
+#include <vector>
 #include "c3CanAC.h"
 #include "BioCro.h"                  // for WINDprof, c3EvapoTrans
 #include "c3photo.h"                 // for c3photoC
@@ -31,22 +32,24 @@ canopy_photosynthesis_outputs c3CanAC(
     double lnb1,
     int lnfun,  // dimensionless switch
     double chil,
-    double StomataWS,                    // dimensionless
-    double specific_heat_of_air,         // J / kg / K
-    double atmospheric_pressure,         // Pa
-    double atmospheric_transmittance,    // dimensionless
-    double atmospheric_scattering,       // dimensionless
-    double growth_respiration_fraction,  // dimensionless
-    double electrons_per_carboxylation,  // self-explanatory units
-    double electrons_per_oxygenation,    // self-explanatory units
-    double absorptivity_par,             // dimensionless
-    double par_energy_content,           // J / micromol
-    double par_energy_fraction,          // dimensionless
-    double leaf_transmittance,           // dimensionless
-    double leaf_reflectance,             // dimensionless
-    double minimum_gbw,                  // mol / m^2 / s
-    double WindSpeedHeight,              // m
-    double beta_PSII                     // dimensionless (fraction of absorbed light that reaches photosystem II)
+    double StomataWS,                        // dimensionless
+    double specific_heat_of_air,             // J / kg / K
+    double atmospheric_pressure,             // Pa
+    double atmospheric_transmittance,        // dimensionless
+    double atmospheric_scattering,           // dimensionless
+    double growth_respiration_fraction,      // dimensionless
+    double electrons_per_carboxylation,      // self-explanatory units
+    double electrons_per_oxygenation,        // self-explanatory units
+    double absorptivity_par,                 // dimensionless
+    double par_energy_content,               // J / micromol
+    double par_energy_fraction,              // dimensionless
+    double leaf_transmittance,               // dimensionless
+    double leaf_reflectance,                 // dimensionless
+    double minimum_gbw,                      // mol / m^2 / s
+    double WindSpeedHeight,                  // m
+    double beta_PSII,                        // dimensionless (fraction of absorbed light that reaches photosystem II)
+    canopy_profile_buffers& buffers,         // storage for the canopy profiles
+    saturation_vapor_pressure_function swvp  // Pa from degrees C
 )
 {
     struct Light_model light_model = lightME(
@@ -60,18 +63,20 @@ canopy_photosynthesis_outputs c3CanAC(
     double q_dir = light_model.direct_fraction * solarR;    // micromol / m^2 / s
     double q_diff = light_model.diffuse_fraction * solarR;  // micromol / m^2 / s
 
-    struct Light_profile light_profile =
-        sunML(q_dir, q_diff, LAI, nlayers, cosine_zenith_angle, kd, chil, absorptivity_par,
-              heightf, par_energy_content, par_energy_fraction,
-              leaf_transmittance, leaf_reflectance);
+    buffers.resize(nlayers);
+
+    Light_profile& light_profile = buffers.light_profile;
+    sunML(q_dir, q_diff, LAI, nlayers, cosine_zenith_angle, kd, chil, absorptivity_par,
+          heightf, par_energy_content, par_energy_fraction,
+          leaf_transmittance, leaf_reflectance, light_profile);
 
     double LAIc = LAI / nlayers;  // dimensionless
 
-    double wind_speed_profile[nlayers];
-    WINDprof(WindSpeed, LAI, nlayers, wind_speed_profile);  // Modifies wind_speed_profile
+    std::vector<double>& wind_speed_profile = buffers.wind_speed_profile;
+    WINDprof(WindSpeed, LAI, nlayers, wind_speed_profile.data());  // Modifies wind_speed_profile
 
-    double leafN_profile[nlayers];
-    LNprof(leafN, LAI, nlayers, kpLN, leafN_profile);  // Modifies leafN_profile
+    std::vector<double>& leafN_profile = buffers.leafN_profile;
+    LNprof(leafN, LAI, nlayers, kpLN, leafN_profile.data());  // Modifies leafN_profile
 
     double CanopyA{0.0};             // micromol / m^2 / s
     double GCanopyA{0.0};            // micromol / m^2 / s
@@ -115,14 +120,14 @@ canopy_photosynthesis_outputs c3CanAC(
                 tpu_rate_max, Rd, b0, b1, Gs_min, Catm, atmospheric_pressure,
                 o2, theta, StomataWS,
                 electrons_per_carboxylation, electrons_per_oxygenation,
-                beta_PSII, gbw_guess)
+                beta_PSII, gbw_guess, swvp)
                 .Gs;  // mmol / m^2 / s
 
         struct ET_Str et_direct =
             c3EvapoTrans(
                 j_avg, ambient_temperature, RH, layer_wind_speed,
                 CanHeight, specific_heat_of_air, direct_gsw_estimate,
-                minimum_gbw, WindSpeedHeight);
+                minimum_gbw, WindSpeedHeight, swvp);
 
         double leaf_temperature_dir = ambient_temperature + et_direct.Deltat;  // degrees C
 
@@ -133,7 +138,7 @@ canopy_photosynthesis_outputs c3CanAC(
                 tpu_rate_max, Rd, b0, b1, Gs_min, Catm, atmospheric_pressure,
                 o2, theta, StomataWS,
                 electrons_per_carboxylation, electrons_per_oxygenation,
-                beta_PSII, et_direct.boundary_layer_conductance);
+                beta_PSII, et_direct.boundary_layer_conductance, swvp);
 
         // Calculations for shaded leaves. First, estimate stomatal conductance
         // by assuming the leaf has the same temperature as the air. Then, use
@@ -151,14 +156,14 @@ canopy_photosynthesis_outputs c3CanAC(
                 tpu_rate_max, Rd, b0, b1, Gs_min, Catm, atmospheric_pressure,
                 o2, theta, StomataWS,
                 electrons_per_carboxylation, electrons_per_oxygenation,
-                beta_PSII, gbw_guess)
+                beta_PSII, gbw_guess, swvp)
                 .Gs;  // mmol / m^2 / s
 
         struct ET_Str et_diffuse =
             c3EvapoTrans(
                 j_avg, ambient_temperature, RH, layer_wind_speed,
                 CanHeight, specific_heat_of_air, diffuse_gsw_estimate,
-                minimum_gbw, WindSpeedHeight);
+                minimum_gbw, WindSpeedHeight, swvp);
 
         double leaf_temperature_Idiffuse = ambient_temperature + et_diffuse.Deltat;  // degrees C
 
@@ -170,7 +175,7 @@ canopy_photosynthesis_outputs c3CanAC(
                 atmospheric_pressure, o2, theta, StomataWS,
                 electrons_per_carboxylation,
                 electrons_per_oxygenation, beta_PSII,
-                et_diffuse.boundary_layer_conductance);
+                et_diffuse.boundary_layer_conductance, swvp);
 
         // Combine sunlit and shaded leaves
         CanopyA += Leafsun * direct_photo.Assim + Leafshade * diffuse_photo.Assim;             // micromol / m^2 / s
@@ -2,6 +2,8 @@
 #define C3CANAC_H
 
 #include "canopy_photosynthesis_outputs.h"  // for canopy_photosynthesis_outputs
+#include "canopy_profile_buffers.h"         // for canopy_profile_buffers
+#include "water_and_air_properties.h"       // for saturation_vapor_pressure_function
 
 canopy_photosynthesis_outputs c3CanAC(
     double LAI,
@@ -44,6 +46,8 @@ canopy_photosynthesis_outputs c3CanAC(
     double leaf_reflectance,
     double minimum_gbw,
     double WindSpeedHeight,
-    double beta_PSII);
+    double beta_PSII,
+    canopy_profile_buffers& buffers,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure);
 
 #endif
@@ -2,8 +2,7 @@
 #include <stdexcept>
 #include "c3photo.h"
 #include "BioCro.h"
-#include "water_and_air_properties.h"  // for saturation_vapor_pressure,
-                                       // TempToDdryA, TempToLHV, SlopeFS
+#include "water_and_air_properties.h"  // for TempToDdryA, TempToLHV, SlopeFS
 #include "../framework/constants.h"    // for ideal_gas_constant, molar_mass_of_water,
                                        // stefan_boltzmann, celsius_to_kelvin
 /**
@@ -14,21 +13,22 @@
  * Mathematical Approach to Plant and Crop Physiology.
  */
 struct ET_Str c3EvapoTrans(
-    double absorbed_shortwave_radiation,  // J / m^2 / s
-    double air_temperature,               // degrees C
-    double RH,                            // Pa / Pa
-    double WindSpeed,                     // m / s
-    double CanopyHeight,                  // meters
-    double specific_heat_of_air,          // J / kg / K
-    double stomatal_conductance,          // mmol / m^2 / s
-    double minimum_gbw,                   // mol / m^2 / s
-    double WindSpeedHeight                // m
+    double absorbed_shortwave_radiation,     // J / m^2 / s
+    double air_temperature,                  // degrees C
+    double RH,                               // Pa / Pa
+    double WindSpeed,                        // m / s
+    double CanopyHeight,                     // meters
+    double specific_heat_of_air,             // J / kg / K
+    double stomatal_conductance,             // mmol / m^2 / s
+    double minimum_gbw,                      // mol / m^2 / s
+    double WindSpeedHeight,                  // m
+    saturation_vapor_pressure_function swvp  // Pa from degrees C
 )
 {
     const double DdryA = TempToDdryA(air_temperature);               // kg / m^3
     const double LHV = TempToLHV(air_temperature);                   // J / kg
     const double SlopeFS = TempToSFS(air_temperature);               // kg / m^3 / K
-    const double SWVP = saturation_vapor_pressure(air_temperature);  // Pa
+    const double SWVP = swvp(air_temperature);                       // Pa
 
     // TODO: This is for about 20 degrees C at 100000 Pa. Change it to use the
     // model state. (1 * R * temperature) / pressure
@@ -72,7 +72,7 @@ void c3_canopy::do_operation() const
         growth_respiration_fraction, electrons_per_carboxylation,
         electrons_per_oxygenation, absorptivity_par, par_energy_content,
         par_energy_fraction, leaf_transmittance, leaf_reflectance, minimum_gbw,
-        windspeed_height, beta_PSII);
+        windspeed_height, beta_PSII, profile_buffers, swvp);
 
     // Update the output quantity list
     update(canopy_assimilation_rate_op, can_result.Assim);         // Mg / ha / hr
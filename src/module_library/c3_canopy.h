@@ -3,6 +3,8 @@
 
 #include "../framework/module.h"
 #include "../framework/state_map.h"
+#include "canopy_profile_buffers.h"    // For canopy_profile_buffers
+#include "water_and_air_properties.h"  // For saturation_vapor_pressure_function
 
 namespace standardBML
 {
@@ -11,7 +13,8 @@ class c3_canopy : public direct_module
    public:
     c3_canopy(
         state_map const& input_quantities,
-        state_map* output_quantities)
+        state_map* output_quantities,
+        saturation_vapor_pressure_function swvp = saturation_vapor_pressure)
         : direct_module{},
 
           // Get references to input quantities
@@ -62,7 +65,12 @@ class c3_canopy : public direct_module
           canopy_transpiration_rate_op{get_op(output_quantities, "canopy_transpiration_rate")},
           canopy_conductance_op{get_op(output_quantities, "canopy_conductance")},
           GrossAssim_op{get_op(output_quantities, "GrossAssim")},
-          canopy_photorespiration_rate_op{get_op(output_quantities, "canopy_photorespiration_rate")}
+          canopy_photorespiration_rate_op{get_op(output_quantities, "canopy_photorespiration_rate")},
+
+          // Allocate storage for the canopy profiles
+          profile_buffers{static_cast<int>(nlayers)},
+
+          swvp{swvp}
     {
     }
     static string_vector get_inputs();
@@ -120,9 +128,38 @@ class c3_canopy : public direct_module
     double* GrossAssim_op;
     double* canopy_photorespiration_rate_op;
 
+    // Storage for the canopy profiles, reused every time the module runs
+    canopy_profile_buffers mutable profile_buffers;
+
+    // Function used to calculate saturation water vapor pressure
+    saturation_vapor_pressure_function const swvp;
+
     // Main operation
     void do_operation() const;
 };
 
+/**
+ * @class c3_canopy_tabulated_swvp
+ *
+ * @brief Identical to `c3_canopy`, except that saturation water vapor pressure
+ * is calculated by `saturation_vapor_pressure_tabulated()` rather than
+ * `saturation_vapor_pressure()` in the leaf photosynthesis and energy balance
+ * calculations.
+ */
+class c3_canopy_tabulated_swvp : public c3_canopy
+{
+   public:
+    c3_canopy_tabulated_swvp(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : c3_canopy{
+              input_quantities,
+              output_quantities,
+              saturation_vapor_pressure_tabulated}
+    {
+    }
+    static std::string get_name() { return "c3_canopy_tabulated_swvp"; }
+};
+
 }  // namespace standardBML
 #endif
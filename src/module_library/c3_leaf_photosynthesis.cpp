@@ -52,7 +52,113 @@ string_vector c3_leaf_photosynthesis::get_outputs()
     };
 }
 
+kernel_field_list<c3_leaf_photosynthesis::kernel_inputs> c3_leaf_photosynthesis::kernel_input_fields()
+{
+    return {
+        {"absorbed_ppfd", &kernel_inputs::absorbed_ppfd},
+        {"temp", &kernel_inputs::temp},
+        {"rh", &kernel_inputs::rh},
+        {"vmax1", &kernel_inputs::vmax1},
+        {"jmax", &kernel_inputs::jmax},
+        {"tpu_rate_max", &kernel_inputs::tpu_rate_max},
+        {"Rd", &kernel_inputs::Rd},
+        {"b0", &kernel_inputs::b0},
+        {"b1", &kernel_inputs::b1},
+        {"Gs_min", &kernel_inputs::Gs_min},
+        {"Catm", &kernel_inputs::Catm},
+        {"atmospheric_pressure", &kernel_inputs::atmospheric_pressure},
+        {"O2", &kernel_inputs::O2},
+        {"theta", &kernel_inputs::theta},
+        {"StomataWS", &kernel_inputs::StomataWS},
+        {"electrons_per_carboxylation", &kernel_inputs::electrons_per_carboxylation},
+        {"electrons_per_oxygenation", &kernel_inputs::electrons_per_oxygenation},
+        {"average_absorbed_shortwave", &kernel_inputs::average_absorbed_shortwave},
+        {"windspeed", &kernel_inputs::windspeed},
+        {"height", &kernel_inputs::height},
+        {"specific_heat_of_air", &kernel_inputs::specific_heat_of_air},
+        {"minimum_gbw", &kernel_inputs::minimum_gbw},
+        {"windspeed_height", &kernel_inputs::windspeed_height},
+        {"beta_PSII", &kernel_inputs::beta_PSII}
+    };
+}
+
+kernel_field_list<c3_leaf_photosynthesis::kernel_outputs> c3_leaf_photosynthesis::kernel_output_fields()
+{
+    return {
+        {"Assim", &kernel_outputs::Assim},
+        {"GrossAssim", &kernel_outputs::GrossAssim},
+        {"Rp", &kernel_outputs::Rp},
+        {"Ci", &kernel_outputs::Ci},
+        {"Gs", &kernel_outputs::Gs},
+        {"Cs", &kernel_outputs::Cs},
+        {"RHs", &kernel_outputs::RHs},
+        {"TransR", &kernel_outputs::TransR},
+        {"EPenman", &kernel_outputs::EPenman},
+        {"EPriestly", &kernel_outputs::EPriestly},
+        {"leaf_temperature", &kernel_outputs::leaf_temperature},
+        {"gbw", &kernel_outputs::gbw}
+    };
+}
+
 void c3_leaf_photosynthesis::do_operation() const
+{
+    kernel_inputs const in{
+        .absorbed_ppfd = absorbed_ppfd,
+        .temp = ambient_temperature,
+        .rh = rh,
+        .vmax1 = vmax1,
+        .jmax = jmax,
+        .tpu_rate_max = tpu_rate_max,
+        .Rd = Rd,
+        .b0 = b0,
+        .b1 = b1,
+        .Gs_min = Gs_min,
+        .Catm = Catm,
+        .atmospheric_pressure = atmospheric_pressure,
+        .O2 = O2,
+        .theta = theta,
+        .StomataWS = StomataWS,
+        .electrons_per_carboxylation = electrons_per_carboxylation,
+        .electrons_per_oxygenation = electrons_per_oxygenation,
+        .average_absorbed_shortwave = average_absorbed_shortwave,
+        .windspeed = windspeed,
+        .height = height,
+        .specific_heat_of_air = specific_heat_of_air,
+        .minimum_gbw = minimum_gbw,
+        .windspeed_height = windspeed_height,
+        .beta_PSII = beta_PSII
+    };
+
+    kernel_outputs const out = kernel(in);
+
+    // Update the outputs
+    update(Assim_op, out.Assim);
+    update(GrossAssim_op, out.GrossAssim);
+    update(Rp_op, out.Rp);
+    update(Ci_op, out.Ci);
+    update(Gs_op, out.Gs);
+    update(Cs_op, out.Cs);
+    update(RHs_op, out.RHs);
+    update(TransR_op, out.TransR);
+    update(EPenman_op, out.EPenman);
+    update(EPriestly_op, out.EPriestly);
+    update(leaf_temperature_op, out.leaf_temperature);
+    update(gbw_op, out.gbw);
+}
+
+/**
+ * @brief Performs the calculations for this module without requiring a module
+ * object, using the input values in `in` and returning the output values.
+ *
+ * The fields of `kernel_inputs` and `kernel_outputs` are named after the
+ * quantities in `get_inputs()` and `get_outputs()`, and `kernel_input_fields()`
+ * and `kernel_output_fields()` pair each of those names with its field. This
+ * allows `multilayer_canopy_photosynthesis` to fill a contiguous array of
+ * inputs for the leaf classes and layers of a canopy by name, and apply this
+ * module to each of them without copying quantities through a separate
+ * `state_map` or making a virtual function call for each leaf.
+ */
+c3_leaf_photosynthesis::kernel_outputs c3_leaf_photosynthesis::kernel(kernel_inputs const& in)
 {
     // Make an initial guess for boundary layer conductance
     double const gbw_guess{1.2};  // mol / m^2 / s
@@ -61,45 +167,47 @@ void c3_leaf_photosynthesis::do_operation() const
     // air temperature
     double const initial_stomatal_conductance =
         c3photoC(
-            absorbed_ppfd, ambient_temperature, ambient_temperature,
-            rh, vmax1, jmax, tpu_rate_max, Rd, b0,
-            b1, Gs_min, Catm, atmospheric_pressure, O2, theta, StomataWS,
-            electrons_per_carboxylation,
-            electrons_per_oxygenation, beta_PSII, gbw_guess)
+            in.absorbed_ppfd, in.temp, in.temp,
+            in.rh, in.vmax1, in.jmax, in.tpu_rate_max, in.Rd, in.b0,
+            in.b1, in.Gs_min, in.Catm, in.atmospheric_pressure, in.O2, in.theta,
+            in.StomataWS, in.electrons_per_carboxylation,
+            in.electrons_per_oxygenation, in.beta_PSII, gbw_guess)
             .Gs;  // mmol / m^2 / s
 
     // Calculate a new value for leaf temperature using the estimate for
     // stomatal conductance
     const ET_Str et =
         c3EvapoTrans(
-            average_absorbed_shortwave, ambient_temperature, rh, windspeed, height,
-            specific_heat_of_air, initial_stomatal_conductance, minimum_gbw,
-            windspeed_height);
+            in.average_absorbed_shortwave, in.temp, in.rh, in.windspeed, in.height,
+            in.specific_heat_of_air, initial_stomatal_conductance, in.minimum_gbw,
+            in.windspeed_height);
 
-    double const leaf_temperature = ambient_temperature + et.Deltat;  // deg. C
+    double const leaf_temperature = in.temp + et.Deltat;  // deg. C
 
     // Calculate final values for assimilation, stomatal conductance, and Ci
     // using the new leaf temperature
     const photosynthesis_outputs photo =
         c3photoC(
-            absorbed_ppfd, leaf_temperature, ambient_temperature,
-            rh, vmax1, jmax,
-            tpu_rate_max, Rd, b0, b1, Gs_min, Catm, atmospheric_pressure, O2,
-            theta, StomataWS,
-            electrons_per_carboxylation, electrons_per_oxygenation, beta_PSII,
+            in.absorbed_ppfd, leaf_temperature, in.temp,
+            in.rh, in.vmax1, in.jmax,
+            in.tpu_rate_max, in.Rd, in.b0, in.b1, in.Gs_min, in.Catm,
+            in.atmospheric_pressure, in.O2, in.theta, in.StomataWS,
+            in.electrons_per_carboxylation, in.electrons_per_oxygenation,
+            in.beta_PSII,
             et.boundary_layer_conductance);
 
-    // Update the outputs
-    update(Assim_op, photo.Assim);
-    update(GrossAssim_op, photo.GrossAssim);
-    update(Rp_op, photo.Rp);
-    update(Ci_op, photo.Ci);
-    update(Gs_op, photo.Gs);
-    update(Cs_op, photo.Cs);
-    update(RHs_op, photo.RHs);
-    update(TransR_op, et.TransR);
-    update(EPenman_op, et.EPenman);
-    update(EPriestly_op, et.EPriestly);
-    update(leaf_temperature_op, leaf_temperature);
-    update(gbw_op, et.boundary_layer_conductance);
+    return kernel_outputs{
+        .Assim = photo.Assim,
+        .GrossAssim = photo.GrossAssim,
+        .Rp = photo.Rp,
+        .Ci = photo.Ci,
+        .Gs = photo.Gs,
+        .Cs = photo.Cs,
+        .RHs = photo.RHs,
+        .TransR = et.TransR,
+        .EPenman = et.EPenman,
+        .EPriestly = et.EPriestly,
+        .leaf_temperature = leaf_temperature,
+        .gbw = et.boundary_layer_conductance
+    };
 }
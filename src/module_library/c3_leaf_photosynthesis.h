@@ -3,6 +3,7 @@
 
 #include "../framework/state_map.h"
 #include "../framework/module.h"
+#include "kernel_fields.h"  // for kernel_field_list
 
 namespace standardBML
 {
@@ -65,6 +66,54 @@ class c3_leaf_photosynthesis : public direct_module
     static string_vector get_outputs();
     static std::string get_name() { return "c3_leaf_photosynthesis"; }
 
+    // Values of the input and output quantities used by `kernel()`, named as
+    // in `get_inputs()` and `get_outputs()`
+    struct kernel_inputs {
+        double absorbed_ppfd;                // micromol / (m^2 leaf) / s
+        double temp;                         // deg. C
+        double rh;                           // dimensionless
+        double vmax1;                        // micromole / m^2 / s
+        double jmax;                         // micromole / m^2 / s
+        double tpu_rate_max;                 // micromole / m^2 / s
+        double Rd;                           // micromole / m^2 / s
+        double b0;                           // mol / m^2 / s
+        double b1;                           // dimensionless
+        double Gs_min;                       // mol / m^2 / s
+        double Catm;                         // micromole / mol
+        double atmospheric_pressure;         // Pa
+        double O2;                           // mmol / mol
+        double theta;                        // dimensionless
+        double StomataWS;                    // dimensionless
+        double electrons_per_carboxylation;  // electron / carboxylation
+        double electrons_per_oxygenation;    // electron / oxygenation
+        double average_absorbed_shortwave;   // J / (m^2 leaf) / s
+        double windspeed;                    // m / s
+        double height;                       // m
+        double specific_heat_of_air;         // J / kg / K
+        double minimum_gbw;                  // mol / m^2 / s
+        double windspeed_height;             // m
+        double beta_PSII;                    // dimensionless (fraction of absorbed light that reaches photosystem II)
+    };
+
+    struct kernel_outputs {
+        double Assim;             // micromol / m^2 /s
+        double GrossAssim;        // micromol / m^2 /s
+        double Rp;                // micromol / m^2 / s
+        double Ci;                // micromole / mol
+        double Gs;                // mmol / m^2 / s
+        double Cs;                // micromol / m^2 / s
+        double RHs;               // dimensionless from Pa / Pa
+        double TransR;            // mmol / m^2 / s
+        double EPenman;           // mmol / m^2 / s
+        double EPriestly;         // mmol / m^2 / s
+        double leaf_temperature;  // deg. C
+        double gbw;               // mol / m^2 / s
+    };
+
+    static kernel_field_list<kernel_inputs> kernel_input_fields();
+    static kernel_field_list<kernel_outputs> kernel_output_fields();
+    static kernel_outputs kernel(kernel_inputs const& in);
+
    private:
     // References to input quantities
     double const& absorbed_ppfd;
@@ -34,7 +34,8 @@ photosynthesis_outputs c3photoC(
     double const electrons_per_carboxylation,  // self-explanatory units
     double const electrons_per_oxygenation,    // self-explanatory units
     double const beta_PSII,                    // dimensionless (fraction of absorbed light that reaches photosystem II)
-    double const gbw                           // mol / m^2 / s
+    double const gbw,                          // mol / m^2 / s
+    saturation_vapor_pressure_function swvp
 )
 {
     // Get leaf temperature in Kelvin
@@ -160,7 +161,8 @@ photosynthesis_outputs c3photoC(
             b1_adj,
             gbw,
             Tleaf,
-            Tambient);
+            Tambient,
+            swvp);
 
         Gs = 1e-3 * BB_res.gsw;  // mol / m^2 / s
 
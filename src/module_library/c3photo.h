@@ -1,7 +1,8 @@
 #ifndef C3PHOTO_H
 #define C3PHOTO_H
 
-#include "photosynthesis_outputs.h"  // for photosynthesis_outputs
+#include "photosynthesis_outputs.h"    // for photosynthesis_outputs
+#include "water_and_air_properties.h"  // for saturation_vapor_pressure_function
 
 photosynthesis_outputs c3photoC(
     double const absorbed_ppfd,
@@ -23,7 +24,8 @@ photosynthesis_outputs c3photoC(
     double const electrons_per_carboxylation,
     double const electrons_per_oxygenation,
     double const beta_PSII,
-    double const gbw);
+    double const gbw,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure);
 
 double solc(double LeafT);
 double solo(double LeafT);
@@ -3,7 +3,8 @@
 
 #include "../framework/module.h"
 #include "../framework/state_map.h"
-#include "CanAC.h"  // For CanAC
+#include "CanAC.h"                   // For CanAC
+#include "canopy_profile_buffers.h"  // For canopy_profile_buffers
 
 namespace standardBML
 {
@@ -12,7 +13,8 @@ class c4_canopy : public direct_module
    public:
     c4_canopy(
         state_map const& input_quantities,
-        state_map* output_quantities)
+        state_map* output_quantities,
+        saturation_vapor_pressure_function swvp = saturation_vapor_pressure)
         : direct_module{},
 
           // Get pointers to input quantities
@@ -70,7 +72,12 @@ class c4_canopy : public direct_module
           canopy_transpiration_rate_op{get_op(output_quantities, "canopy_transpiration_rate")},
           canopy_conductance_op{get_op(output_quantities, "canopy_conductance")},
           GrossAssim_op{get_op(output_quantities, "GrossAssim")},
-          canopy_photorespiration_rate_op{get_op(output_quantities, "canopy_photorespiration_rate")}
+          canopy_photorespiration_rate_op{get_op(output_quantities, "canopy_photorespiration_rate")},
+
+          // Allocate storage for the canopy profiles
+          profile_buffers{static_cast<int>(nlayers)},
+
+          swvp{swvp}
     {
     }
     static string_vector get_inputs();
@@ -135,6 +142,12 @@ class c4_canopy : public direct_module
     double* GrossAssim_op;
     double* canopy_photorespiration_rate_op;
 
+    // Storage for the canopy profiles, reused every time the module runs
+    canopy_profile_buffers mutable profile_buffers;
+
+    // Function used to calculate saturation water vapor pressure
+    saturation_vapor_pressure_function const swvp;
+
     // Main operation
     void do_operation() const;
 };
@@ -226,7 +239,8 @@ void c4_canopy::do_operation() const
         kpLN, lnfun, upperT, lowerT, nitroP, leafwidth, et_equation, StomataWS,
         specific_heat_of_air, atmospheric_pressure, atmospheric_transmittance,
         atmospheric_scattering, absorptivity_par, par_energy_content,
-        par_energy_fraction, leaf_transmittance, leaf_reflectance, minimum_gbw);
+        par_energy_fraction, leaf_transmittance, leaf_reflectance, minimum_gbw,
+        profile_buffers, swvp);
 
     // Update the parameter list
     update(canopy_assimilation_rate_op, can_result.Assim);         // Mg / ha / hr
@@ -236,5 +250,28 @@ void c4_canopy::do_operation() const
     update(canopy_photorespiration_rate_op, can_result.Rp);        // Mg / ha / hr
 }
 
+/**
+ * @class c4_canopy_tabulated_swvp
+ *
+ * @brief Identical to `c4_canopy`, except that saturation water vapor pressure
+ * is calculated by `saturation_vapor_pressure_tabulated()` rather than
+ * `saturation_vapor_pressure()` in the leaf photosynthesis and energy balance
+ * calculations.
+ */
+class c4_canopy_tabulated_swvp : public c4_canopy
+{
+   public:
+    c4_canopy_tabulated_swvp(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : c4_canopy{
+              input_quantities,
+              output_quantities,
+              saturation_vapor_pressure_tabulated}
+    {
+    }
+    static std::string get_name() { return "c4_canopy_tabulated_swvp"; }
+};
+
 }  // namespace standardBML
 #endif
@@ -52,7 +52,107 @@ string_vector c4_leaf_photosynthesis::get_outputs()
     };
 }
 
+kernel_field_list<c4_leaf_photosynthesis::kernel_inputs> c4_leaf_photosynthesis::kernel_input_fields()
+{
+    return {
+        {"incident_ppfd", &kernel_inputs::incident_ppfd},
+        {"temp", &kernel_inputs::temp},
+        {"rh", &kernel_inputs::rh},
+        {"vmax1", &kernel_inputs::vmax1},
+        {"alpha1", &kernel_inputs::alpha1},
+        {"kparm", &kernel_inputs::kparm},
+        {"theta", &kernel_inputs::theta},
+        {"beta", &kernel_inputs::beta},
+        {"Rd", &kernel_inputs::Rd},
+        {"b0", &kernel_inputs::b0},
+        {"b1", &kernel_inputs::b1},
+        {"Gs_min", &kernel_inputs::Gs_min},
+        {"StomataWS", &kernel_inputs::StomataWS},
+        {"Catm", &kernel_inputs::Catm},
+        {"atmospheric_pressure", &kernel_inputs::atmospheric_pressure},
+        {"upperT", &kernel_inputs::upperT},
+        {"lowerT", &kernel_inputs::lowerT},
+        {"average_absorbed_shortwave", &kernel_inputs::average_absorbed_shortwave},
+        {"absorbed_shortwave", &kernel_inputs::absorbed_shortwave},
+        {"windspeed", &kernel_inputs::windspeed},
+        {"leafwidth", &kernel_inputs::leafwidth},
+        {"specific_heat_of_air", &kernel_inputs::specific_heat_of_air},
+        {"minimum_gbw", &kernel_inputs::minimum_gbw},
+        {"et_equation", &kernel_inputs::et_equation}
+    };
+}
+
+kernel_field_list<c4_leaf_photosynthesis::kernel_outputs> c4_leaf_photosynthesis::kernel_output_fields()
+{
+    return {
+        {"Assim", &kernel_outputs::Assim},
+        {"GrossAssim", &kernel_outputs::GrossAssim},
+        {"Rp", &kernel_outputs::Rp},
+        {"Ci", &kernel_outputs::Ci},
+        {"Gs", &kernel_outputs::Gs},
+        {"Cs", &kernel_outputs::Cs},
+        {"RHs", &kernel_outputs::RHs},
+        {"TransR", &kernel_outputs::TransR},
+        {"EPenman", &kernel_outputs::EPenman},
+        {"EPriestly", &kernel_outputs::EPriestly},
+        {"leaf_temperature", &kernel_outputs::leaf_temperature},
+        {"gbw", &kernel_outputs::gbw}
+    };
+}
+
 void c4_leaf_photosynthesis::do_operation() const
+{
+    kernel_inputs const in{
+        .incident_ppfd = incident_ppfd,
+        .temp = ambient_temperature,
+        .rh = rh,
+        .vmax1 = vmax1,
+        .alpha1 = alpha1,
+        .kparm = kparm,
+        .theta = theta,
+        .beta = beta,
+        .Rd = Rd,
+        .b0 = b0,
+        .b1 = b1,
+        .Gs_min = Gs_min,
+        .StomataWS = StomataWS,
+        .Catm = Catm,
+        .atmospheric_pressure = atmospheric_pressure,
+        .upperT = upperT,
+        .lowerT = lowerT,
+        .average_absorbed_shortwave = average_absorbed_shortwave,
+        .absorbed_shortwave = absorbed_shortwave,
+        .windspeed = windspeed,
+        .leafwidth = leafwidth,
+        .specific_heat_of_air = specific_heat_of_air,
+        .minimum_gbw = minimum_gbw,
+        .et_equation = et_equation
+    };
+
+    kernel_outputs const out = kernel(in);
+
+    // Update the outputs
+    update(Assim_op, out.Assim);
+    update(GrossAssim_op, out.GrossAssim);
+    update(Rp_op, out.Rp);
+    update(Ci_op, out.Ci);
+    update(Gs_op, out.Gs);
+    update(Cs_op, out.Cs);
+    update(RHs_op, out.RHs);
+    update(TransR_op, out.TransR);
+    update(EPenman_op, out.EPenman);
+    update(EPriestly_op, out.EPriestly);
+    update(leaf_temperature_op, out.leaf_temperature);
+    update(gbw_op, out.gbw);
+}
+
+/**
+ * @brief Performs the calculations for this module without requiring a module
+ * object, using the input values in `in` and returning the output values.
+ *
+ * See `c3_leaf_photosynthesis::kernel()` for more details.
+ */
+c4_leaf_photosynthesis::kernel_outputs c4_leaf_photosynthesis::kernel(kernel_inputs const& in)
 {
     // Make an initial guess for boundary layer conductance
     double const gbw_guess{1.2};  // mol / m^2 / s
@@ -61,42 +161,43 @@ void c4_leaf_photosynthesis::do_operation() const
     // air temperature
     const double initial_stomatal_conductance =
         c4photoC(
-            incident_ppfd, ambient_temperature, ambient_temperature,
-            rh, vmax1, alpha1, kparm, theta, beta,
-            Rd, b0, b1, Gs_min, StomataWS, Catm, atmospheric_pressure,
-            upperT, lowerT, gbw_guess)
+            in.incident_ppfd, in.temp, in.temp,
+            in.rh, in.vmax1, in.alpha1, in.kparm, in.theta, in.beta,
+            in.Rd, in.b0, in.b1, in.Gs_min, in.StomataWS, in.Catm,
+            in.atmospheric_pressure, in.upperT, in.lowerT, gbw_guess)
             .Gs;  // mmol / m^2 / s
 
     // Calculate a new value for leaf temperature
     const ET_Str et =
         EvapoTrans2(
-            absorbed_shortwave, average_absorbed_shortwave, ambient_temperature, rh, windspeed,
-            initial_stomatal_conductance, leafwidth, specific_heat_of_air,
-            minimum_gbw, et_equation);
+            in.absorbed_shortwave, in.average_absorbed_shortwave, in.temp,
+            in.rh, in.windspeed, initial_stomatal_conductance, in.leafwidth,
+            in.specific_heat_of_air, in.minimum_gbw, in.et_equation);
 
-    const double leaf_temperature = ambient_temperature + et.Deltat;  // deg. C
+    const double leaf_temperature = in.temp + et.Deltat;  // deg. C
 
     // Calculate final values for assimilation, stomatal conductance, and Ci
     // using the new leaf temperature
     const photosynthesis_outputs photo =
         c4photoC(
-            incident_ppfd, leaf_temperature, ambient_temperature,
-            rh, vmax1, alpha1, kparm,
-            theta, beta, Rd, b0, b1, Gs_min, StomataWS, Catm,
-            atmospheric_pressure, upperT, lowerT,
+            in.incident_ppfd, leaf_temperature, in.temp,
+            in.rh, in.vmax1, in.alpha1, in.kparm,
+            in.theta, in.beta, in.Rd, in.b0, in.b1, in.Gs_min, in.StomataWS,
+            in.Catm, in.atmospheric_pressure, in.upperT, in.lowerT,
             et.boundary_layer_conductance);
 
-    // Update the outputs
-    update(Assim_op, photo.Assim);
-    update(GrossAssim_op, photo.GrossAssim);
-    update(Rp_op, photo.Rp);
-    update(Ci_op, photo.Ci);
-    update(Gs_op, photo.Gs);
-    update(Cs_op, photo.Cs);
-    update(RHs_op, photo.RHs);
-    update(TransR_op, et.TransR);
-    update(EPenman_op, et.EPenman);
-    update(EPriestly_op, et.EPriestly);
-    update(leaf_temperature_op, leaf_temperature);
-    update(gbw_op, et.boundary_layer_conductance);
+    return kernel_outputs{
+        .Assim = photo.Assim,
+        .GrossAssim = photo.GrossAssim,
+        .Rp = photo.Rp,
+        .Ci = photo.Ci,
+        .Gs = photo.Gs,
+        .Cs = photo.Cs,
+        .RHs = photo.RHs,
+        .TransR = et.TransR,
+        .EPenman = et.EPenman,
+        .EPriestly = et.EPriestly,
+        .leaf_temperature = leaf_temperature,
+        .gbw = et.boundary_layer_conductance
+    };
 }
@@ -1,4 +1,5 @@
 #include <cmath>                          // for pow, exp
+#include <algorithm>                      // for std::min
 #include "ball_berry_gs.h"                // for ball_berry_gs
 #include "conductance_limited_assim.h"    // for conductance_limited_assim
 #include "../framework/constants.h"       // for dr_stomata, dr_boundary
@@ -27,7 +28,8 @@ photosynthesis_outputs c4photoC(
     double const atmospheric_pressure,  // Pa
     double const upperT,                // degrees C
     double const lowerT,                // degrees C
-    double const gbw                    // mol / m^2 / s
+    double const gbw,                   // mol / m^2 / s
+    saturation_vapor_pressure_function swvp
 )
 {
     constexpr double k_Q10 = 2;  // dimensionless. Increase in a reaction rate per temperature increase of 10 degrees Celsius.
@@ -104,7 +106,8 @@ photosynthesis_outputs c4photoC(
             bb1_adj,
             gbw,
             leaf_temperature,
-            ambient_temperature);
+            ambient_temperature,
+            swvp);
 
         Gs = BB_res.gsw;  // mmol / m^2 / s
 
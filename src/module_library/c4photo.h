@@ -1,7 +1,8 @@
 #ifndef C4PHOTO_H
 #define C4PHOTO_H
 
-#include "photosynthesis_outputs.h"  // for photosynthesis_outputs
+#include "photosynthesis_outputs.h"    // for photosynthesis_outputs
+#include "water_and_air_properties.h"  // for saturation_vapor_pressure_function
 
 photosynthesis_outputs c4photoC(
     double const Qp,
@@ -22,6 +23,7 @@ photosynthesis_outputs c4photoC(
     double const atmospheric_pressure,
     double const upperT,
     double const lowerT,
-    double const gbw);
+    double const gbw,
+    saturation_vapor_pressure_function swvp = saturation_vapor_pressure);
 
 #endif
@@ -0,0 +1,33 @@
+#ifndef CANOPY_PROFILE_BUFFERS_H
+#define CANOPY_PROFILE_BUFFERS_H
+
+#include <vector>
+#include "sunML.h"  // for Light_profile
+
+/**
+ * @brief Storage for the layer-by-layer profiles calculated while determining
+ * canopy photosynthesis.
+ *
+ * A module that calculates these profiles can own one of these objects, sized
+ * to its number of layers when the module is created, and pass it to each
+ * calculation so the profiles are not reallocated every time the module runs.
+ * Since modules are not shared between simulations, this does not prevent
+ * several simulations from running at the same time.
+ */
+struct canopy_profile_buffers {
+    canopy_profile_buffers() {}
+    explicit canopy_profile_buffers(int nlayers) { resize(nlayers); }
+
+    void resize(int nlayers)
+    {
+        light_profile.resize(nlayers);
+        wind_speed_profile.resize(nlayers);
+        leafN_profile.resize(nlayers);
+    }
+
+    Light_profile light_profile;
+    std::vector<double> wind_speed_profile;  // m / s
+    std::vector<double> leafN_profile;       // same units as `LeafN`
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef GROWTH_HISTORY_H
+#define GROWTH_HISTORY_H
+
+#include <vector>
+#include <algorithm>  // for std::max
+#include <stdexcept>  // for std::out_of_range
+
+/**
+ * @brief Stores a history of values recorded once per time step, where each
+ * value is identified by the index of the step when it was recorded.
+ *
+ * Modules like `thermal_time_senescence` record a growth rate at every step
+ * and later look back at the rate from an earlier step. The index they use
+ * never decreases, so once it has moved past a value, that value can be
+ * discarded with `discard_before()`. The values are stored in a circular
+ * buffer that is only enlarged when it is full, so the memory used depends on
+ * how far back the module looks rather than on the length of the simulation.
+ */
+class growth_history
+{
+   public:
+    growth_history() {}
+
+    /** Records the value for the next step */
+    void push_back(double value)
+    {
+        if (count == buffer.size()) {
+            grow();
+        }
+        buffer[(head + count) % buffer.size()] = value;
+        ++count;
+    }
+
+    /** Returns the value recorded at step `index`, which must not have been
+     * discarded. Like `std::vector::at()`, this throws an exception if no
+     * value has been recorded at that step. */
+    double at(double index) const
+    {
+        if (!(index >= first) || index >= first + count) {
+            throw std::out_of_range(
+                "growth_history: the requested step has not been recorded "
+                "or has already been discarded");
+        }
+        size_t const i = static_cast<size_t>(index) - first;
+        return buffer[(head + i) % buffer.size()];
+    }
+
+    /** Discards the values from all steps before step `index` */
+    void discard_before(double index)
+    {
+        while (count > 0 && first + 1 <= index) {
+            head = (head + 1) % buffer.size();
+            --count;
+            ++first;
+        }
+    }
+
+    /** Returns the number of values currently stored */
+    size_t size() const { return count; }
+
+   private:
+    std::vector<double> buffer;
+    size_t head{0};   // position in `buffer` of the oldest stored value
+    size_t count{0};  // number of stored values
+    size_t first{0};  // step index of the oldest stored value
+
+    void grow()
+    {
+        std::vector<double> larger(std::max(2 * buffer.size(), size_t(64)));
+        for (size_t i = 0; i < count; ++i) {
+            larger[i] = buffer[(head + i) % buffer.size()];
+        }
+        buffer.swap(larger);
+        head = 0;
+    }
+};
+
+#endif
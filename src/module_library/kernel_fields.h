@@ -0,0 +1,71 @@
+#ifndef KERNEL_FIELDS_H
+#define KERNEL_FIELDS_H
+
+#include <algorithm>  // for std::find_if
+#include <stdexcept>  // for std::logic_error
+#include <string>
+#include <utility>  // for std::pair
+#include <vector>
+#include "../framework/state_map.h"  // for string_vector
+
+/**
+ * @brief A list that pairs the name of each quantity held by a struct of
+ * doubles with the member of the struct that holds it.
+ *
+ * Modules with a static `kernel()` method use these lists to describe the
+ * fields of their `kernel_inputs` and `kernel_outputs` structs, so that other
+ * modules (such as `multilayer_canopy_photosynthesis`) can fill and read them
+ * by name.
+ */
+template <typename fields_type>
+using kernel_field_list = std::vector<std::pair<std::string, double fields_type::*>>;
+
+/**
+ * @brief Returns the member of `fields_type` that holds each of the quantities
+ * in `names`, in the same order as `names`.
+ *
+ * An exception is thrown if `fields` does not list every member of
+ * `fields_type`, if `fields` and `names` have different lengths, or if any
+ * name has no corresponding field, since any of these would mean that a
+ * module's kernel disagrees with its `get_inputs()` or `get_outputs()` method.
+ */
+template <typename fields_type>
+std::vector<double fields_type::*> get_kernel_fields(
+    kernel_field_list<fields_type> const& fields,
+    string_vector const& names)
+{
+    if (fields.size() * sizeof(double) != sizeof(fields_type)) {
+        throw std::logic_error(
+            "Thrown by get_kernel_fields: not every member of the kernel "
+            "struct is included in its list of fields.\n");
+    }
+
+    if (fields.size() != names.size()) {
+        throw std::logic_error(
+            "Thrown by get_kernel_fields: the kernel struct has " +
+            std::to_string(fields.size()) + " fields, but " +
+            std::to_string(names.size()) + " quantity names were supplied.\n");
+    }
+
+    std::vector<double fields_type::*> result;
+
+    for (std::string const& name : names) {
+        auto it = std::find_if(
+            fields.begin(), fields.end(),
+            [&name](std::pair<std::string, double fields_type::*> const& field) {
+                return field.first == name;
+            });
+
+        if (it == fields.end()) {
+            throw std::logic_error(
+                "Thrown by get_kernel_fields: the kernel struct has no field "
+                "for the `" + name + "` quantity.\n");
+        }
+
+        result.push_back(it->second);
+    }
+
+    return result;
+}
+
+#endif
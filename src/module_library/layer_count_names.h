@@ -0,0 +1,44 @@
+#ifndef LAYER_COUNT_NAMES_H
+#define LAYER_COUNT_NAMES_H
+
+#include <string>
+
+namespace standardBML
+{
+/**
+ * @class layer_count_name
+ *
+ * @brief Provides the word that begins the name of a multilayer module with a
+ * fixed number of layers; for example, `ten` in `ten_layer_canopy_properties`
+ * or `ten_layer_soil_water`.
+ *
+ * Only the layer counts that are registered in the module library have a
+ * specialization, so using any other count is a compile-time error. To make a
+ * new layer count available, add a specialization here and register the
+ * corresponding `n_layer_*` modules in `module_library.cpp`.
+ */
+template <int nlayers>
+struct layer_count_name;
+
+template <>
+struct layer_count_name<3> {
+    static std::string get() { return "three"; }
+};
+
+template <>
+struct layer_count_name<5> {
+    static std::string get() { return "five"; }
+};
+
+template <>
+struct layer_count_name<10> {
+    static std::string get() { return "ten"; }
+};
+
+template <>
+struct layer_count_name<20> {
+    static std::string get() { return "twenty"; }
+};
+
+}  // namespace standardBML
+#endif
@@ -0,0 +1,224 @@
+#include <algorithm>  // for std::min, std::min_element
+#include <cmath>      // for floor, fmod, remainder, round
+#include <map>
+#include <mutex>
+#include "../framework/degree_trigonometry.h"  // for atan2_deg, cos_deg, sin_deg, acos_deg, asin_deg
+#include "michalsky_solar_coordinates.h"
+
+namespace
+{
+double constexpr deg_to_hr = 1.0 / 15.0;
+double constexpr hr_to_deg = 15.0;
+double constexpr hr_per_day = 24.0;
+double constexpr deg_per_rev = 360.0;
+
+double constexpr jd_ref_1948 = 2432916.5;  // Julian date at midnight on 31 December 1948 (UTC)
+double constexpr jd_ref_2000 = 2451545.0;  // Julian date at noon on 1 January 2000 (UTC)
+
+// Range and spacing of the times in a `michalsky_celestial_table`
+double constexpr table_first_time = -1.0;       // days
+double constexpr table_last_time = 368.0;       // days
+double constexpr table_time_step = 1.0 / 24.0;  // days
+}  // namespace
+
+/**
+ *  @brief Converts a time expressed as a fractional day of year in a local
+ *  time zone into the Julian date and the "n" date, following Section 2.1 of
+ *  the Michalsky paper.
+ */
+michalsky_time michalsky_time_conversion(
+    double time,              // days (fractional day of year)
+    double time_zone_offset,  // hours
+    double year               // years
+)
+{
+    // Unpack the doy and hour in UTC
+    double const time_utc = time - time_zone_offset / hr_per_day;  // days
+    double const doy_utc = floor(time_utc);                        // days
+    double const hour_utc = hr_per_day * (time_utc - doy_utc);     // hours
+
+    // Calculate the Julian date
+    double const delta = year - 1949.0;
+    double const leap = floor(0.25 * delta);
+    double const jd = jd_ref_1948 + delta * 365.0 + leap + doy_utc + hour_utc / hr_per_day;  // days
+
+    // Calculate the "n" date
+    double const n = jd - jd_ref_2000;  // days
+
+    return michalsky_time{time_utc, hour_utc, jd, n};
+}
+
+/**
+ *  @brief Calculates the ecliptic and equatorial celestial coordinates of the
+ *  sun, following Sections 2.2 and 2.3 of the Michalsky paper.
+ */
+michalsky_celestial_coordinates michalsky_celestial(
+    double n  // days
+)
+{
+    // Calculate the ecliptic coordinates of the sun
+    double const L = fmod(280.460 + 0.9856474 * n, deg_per_rev);                            // degrees
+    double const g = fmod(357.528 + 0.9856003 * n, deg_per_rev);                            // degrees
+    double const ell = fmod(L + 1.915 * sin_deg(g) + 0.020 * sin_deg(2 * g), deg_per_rev);  // degrees
+    double const ep = 23.439 - 0.0000004 * n;                                               // degrees
+
+    // Calculate the equatorial celestial coordinates of the sun
+    double const ra = atan2_deg(cos_deg(ep) * sin_deg(ell), cos_deg(ell));  // degrees
+    double const dec = asin_deg(sin_deg(ep) * sin_deg(ell));                // degrees
+
+    return michalsky_celestial_coordinates{L, g, ell, ep, ra, dec};
+}
+
+/**
+ *  @brief Calculates the sidereal time and the coordinates of the sun in the
+ *  local sky, following Section 2.4 and Equations 3 - 5 of the Michalsky
+ *  paper.
+ */
+michalsky_local_coordinates michalsky_local(
+    michalsky_time const& t,
+    michalsky_celestial_coordinates const& c,
+    double lat,       // degrees
+    double longitude  // degrees
+)
+{
+    // Calculate the sidereal time
+    double const gmst = fmod(6.697375 + 0.0657098242 * t.n + t.hour_utc, hr_per_day);  // hours
+    double const lmst = fmod(gmst + longitude * deg_to_hr, hr_per_day);                // hours
+
+    // Convert to local coordinates
+    double const lha = fmod(lmst * hr_to_deg - c.ra, deg_per_rev);  // degrees
+
+    double const zen = acos_deg(sin_deg(c.dec) * sin_deg(lat) +
+                                cos_deg(c.dec) * cos_deg(lat) * cos_deg(lha));  // degrees
+
+    double az = asin_deg(-cos_deg(c.dec) * sin_deg(lha) / cos_deg(90.0 - zen));  // degrees
+
+    // Make sure azimuth is in the correct quadrant
+    double const el = 90.0 - zen;                                        // degrees
+    double const el_critical = asin_deg(sin_deg(c.dec) / sin_deg(lat));  // degrees
+
+    if (el >= el_critical) {
+        az = 180.0 - az;  // degrees
+    } else if (lha > 0) {
+        az = 360.0 + az;  // degrees
+    }
+
+    // Determine the cosine of the zenith angle
+    double const cos_zen = cos_deg(zen);  // dimensionless
+
+    return michalsky_local_coordinates{gmst, lmst, lha, zen, az, cos_zen};
+}
+
+/**
+ *  @brief Builds a table for one year.
+ *
+ *  Only the quantities that require trigonometric functions are stored: the
+ *  equation of center (the difference between the ecliptic longitude and the
+ *  mean longitude), the right ascension, and the declination. The right
+ *  ascension is stored without the jumps of 360 degrees that occur when it
+ *  passes 180 degrees, so it can be interpolated.
+ */
+michalsky_celestial_table::michalsky_celestial_table(int year)
+    : year{year}
+{
+    size_t const size =
+        static_cast<size_t>(std::round((table_last_time - table_first_time) / table_time_step)) + 1;
+
+    equation_of_center.reserve(size);
+    ra.reserve(size);
+    dec.reserve(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        michalsky_time const t = michalsky_time_conversion(
+            table_first_time + i * table_time_step, 0.0, year);
+
+        michalsky_celestial_coordinates const c = michalsky_celestial(t.n);
+
+        equation_of_center.push_back(
+            1.915 * sin_deg(c.g) + 0.020 * sin_deg(2 * c.g));
+
+        double ra_i = c.ra;
+        if (i > 0) {
+            ra_i += deg_per_rev * std::round((ra.back() - ra_i) / deg_per_rev);
+        }
+        ra.push_back(ra_i);
+
+        dec.push_back(c.dec);
+    }
+}
+
+/**
+ *  @brief Returns the table for `year`, building it only if it is not already
+ *  in the cache.
+ *
+ *  When the cache is full, the table that was least recently requested is
+ *  removed from it to make room for the new one.
+ */
+std::shared_ptr<michalsky_celestial_table const> michalsky_celestial_table::get(int year)
+{
+    struct cache_entry {
+        std::shared_ptr<michalsky_celestial_table const> table;
+        unsigned long last_request;
+    };
+
+    static std::mutex table_mutex;
+    static std::map<int, cache_entry> tables;
+    static unsigned long n_requests = 0;
+
+    std::lock_guard<std::mutex> lock(table_mutex);
+
+    ++n_requests;
+
+    auto it = tables.find(year);
+    if (it == tables.end()) {
+        if (tables.size() >= max_cached_tables) {
+            tables.erase(std::min_element(
+                tables.begin(), tables.end(),
+                [](std::pair<int const, cache_entry> const& a,
+                   std::pair<int const, cache_entry> const& b) {
+                    return a.second.last_request < b.second.last_request;
+                }));
+        }
+
+        it = tables.emplace(
+                       year,
+                       cache_entry{std::make_shared<michalsky_celestial_table const>(year), 0})
+                 .first;
+    }
+
+    it->second.last_request = n_requests;
+    return it->second.table;
+}
+
+bool michalsky_celestial_table::covers(double time_utc) const
+{
+    return time_utc >= table_first_time && time_utc < table_last_time;
+}
+
+/**
+ *  @brief Determines the celestial coordinates at time `t`, which must be
+ *  covered by the table, using linear interpolation.
+ *
+ *  The mean longitude, mean anomaly, and obliquity are simple functions of
+ *  the time, so they are calculated exactly. Over one hour, the interpolation
+ *  errors in the other coordinates are smaller than 1e-5 degrees.
+ */
+michalsky_celestial_coordinates michalsky_celestial_table::interpolate(michalsky_time const& t) const
+{
+    double const x = (t.time_utc - table_first_time) / table_time_step;
+    size_t const i = std::min(static_cast<size_t>(x), dec.size() - 2);
+    double const f = x - i;
+
+    auto lerp = [i, f](std::vector<double> const& v) {
+        return v[i] + f * (v[i + 1] - v[i]);
+    };
+
+    double const L = fmod(280.460 + 0.9856474 * t.n, deg_per_rev);        // degrees
+    double const g = fmod(357.528 + 0.9856003 * t.n, deg_per_rev);        // degrees
+    double const ell = fmod(L + lerp(equation_of_center), deg_per_rev);  // degrees
+    double const ep = 23.439 - 0.0000004 * t.n;                           // degrees
+    double const ra_t = remainder(lerp(ra), deg_per_rev);                // degrees
+    double const dec_t = lerp(dec);                                       // degrees
+
+    return michalsky_celestial_coordinates{L, g, ell, ep, ra_t, dec_t};
+}
@@ -0,0 +1,102 @@
+#ifndef MICHALSKY_SOLAR_COORDINATES_H
+#define MICHALSKY_SOLAR_COORDINATES_H
+
+#include <memory>  // for std::shared_ptr
+#include <vector>
+
+/**
+ *  @brief The time expressed in the forms used by the Michalsky solar position
+ *  model; see `solar_position_michalsky` for more details.
+ */
+struct michalsky_time {
+    double time_utc;  // days
+    double hour_utc;  // hours
+    double jd;        // days (Julian date)
+    double n;         // days (difference from noon on 1 January 2000 UTC)
+};
+
+/**
+ *  @brief Coordinates of the sun that only depend on the time, i.e., the
+ *  ecliptic and equatorial celestial coordinates.
+ */
+struct michalsky_celestial_coordinates {
+    double L;    // degrees (mean longitude)
+    double g;    // degrees (mean anomaly)
+    double ell;  // degrees (ecliptic longitude)
+    double ep;   // degrees (obliquity of the ecliptic)
+    double ra;   // degrees (right ascension)
+    double dec;  // degrees (declination)
+};
+
+/**
+ *  @brief Sidereal times and coordinates of the sun in the local sky.
+ */
+struct michalsky_local_coordinates {
+    double gmst;     // hours
+    double lmst;     // hours
+    double lha;      // degrees
+    double zen;      // degrees
+    double az;       // degrees
+    double cos_zen;  // dimensionless
+};
+
+michalsky_time michalsky_time_conversion(
+    double time,              // days (fractional day of year)
+    double time_zone_offset,  // hours
+    double year               // years
+);
+
+michalsky_celestial_coordinates michalsky_celestial(
+    double n  // days
+);
+
+michalsky_local_coordinates michalsky_local(
+    michalsky_time const& t,
+    michalsky_celestial_coordinates const& c,
+    double lat,       // degrees
+    double longitude  // degrees
+);
+
+/**
+ *  @class michalsky_celestial_table
+ *
+ *  @brief Stores the slowly-varying parts of the sun's celestial coordinates
+ *  at hourly intervals throughout one year so they can be interpolated rather
+ *  than recalculated.
+ *
+ *  The table covers UTC times from day -1 to day 368 of the year, which
+ *  includes every time in the year in any time zone. It does not depend on the
+ *  location, so one table can be used at every site.
+ *
+ *  Tables are built by `get()`, which keeps the tables for the most recently
+ *  requested years and returns the same table when it is called again for one
+ *  of those years, even from several threads at once. At most
+ *  `max_cached_tables` tables are kept; a table that is no longer cached stays
+ *  valid for as long as anything still holds a pointer to it. Tables are never
+ *  modified once they have been built.
+ */
+class michalsky_celestial_table
+{
+   public:
+    explicit michalsky_celestial_table(int year);
+
+    static std::shared_ptr<michalsky_celestial_table const> get(int year);
+
+    static size_t constexpr max_cached_tables = 16;
+
+    int get_year() const { return year; }
+
+    bool covers(double time_utc) const;
+
+    michalsky_celestial_coordinates interpolate(michalsky_time const& t) const;
+
+   private:
+    int const year;
+
+    // Values at each time in the table
+    std::vector<double> equation_of_center;  // degrees
+    std::vector<double> ra;                  // degrees, without jumps of 360
+    std::vector<double> dec;                 // degrees
+};
+
+#endif
@@ -5,7 +5,8 @@
 // the namespace in this file to match the one defined in `module_library.h`.
 // See that file for more details. It will also be necessary to include
 // different module header files and to make corresponding changes to the
-// entries in the `creator_map` table.
+// entries in the `creator_map` and `switching_function_map` tables and the list
+// of history-dependent modules.
 
 // Include all the header files that define the modules.
 #include "harmonic_oscillator.h"  // Contains harmonic_oscillator and harmonic_energy
@@ -13,6 +14,7 @@
 #include "one_layer_soil_profile.h"
 #include "one_layer_soil_profile_derivatives.h"
 #include "two_layer_soil_profile.h"
+#include "multilayer_soil_water.h"
 #include "soil_evaporation.h"
 #include "parameter_calculator.h"
 #include "c3_canopy.h"
@@ -76,11 +78,13 @@
 #include "no_leaf_resp_neg_assim_partitioning_growth_calculator.h"
 #include "rasmussen_specific_heat.h"
 #include "buck_swvp.h"
+#include "buck_swvp_tabulated.h"
 #include "rh_to_mole_fraction.h"
 #include "total_biomass.h"
 #include "grimm_soybean_flowering.h"
 #include "grimm_soybean_flowering_calculator.h"
 #include "solar_position_michalsky.h"
+#include "solar_position_michalsky_tabulated.h"
 #include "leaf_gbw_thornley.h"
 #include "leaf_gbw_nikolov.h"
 #include "example_model_mass_gain.h"
@@ -96,10 +100,17 @@ creator_map standardBML::module_library::library_entries =
      {"one_layer_soil_profile",                                &create_mc<one_layer_soil_profile>},
      {"one_layer_soil_profile_derivatives",                    &create_mc<one_layer_soil_profile_derivatives>},
      {"two_layer_soil_profile",                                &create_mc<two_layer_soil_profile>},
+     {"three_layer_soil_water",                                &create_mc<three_layer_soil_water>},
+     {"five_layer_soil_water",                                 &create_mc<five_layer_soil_water>},
+     {"ten_layer_soil_water",                                  &create_mc<ten_layer_soil_water>},
+     {"twenty_layer_soil_water",                               &create_mc<twenty_layer_soil_water>},
      {"soil_evaporation",                                      &create_mc<soil_evaporation>},
+     {"soil_evaporation_tabulated_swvp",                       &create_mc<soil_evaporation_tabulated_swvp>},
      {"parameter_calculator",                                  &create_mc<parameter_calculator>},
      {"c3_canopy",                                             &create_mc<c3_canopy>},
+     {"c3_canopy_tabulated_swvp",                              &create_mc<c3_canopy_tabulated_swvp>},
      {"c4_canopy",                                             &create_mc<c4_canopy>},
+     {"c4_canopy_tabulated_swvp",                              &create_mc<c4_canopy_tabulated_swvp>},
      {"varying_Jmax25",                                        &create_mc<varying_Jmax25>},
      {"stomata_water_stress_linear",                           &create_mc<stomata_water_stress_linear>},
      {"stomata_water_stress_exponential",                      &create_mc<stomata_water_stress_exponential>},
@@ -122,7 +133,9 @@ creator_map standardBML::module_library::library_entries =
      {"thermal_time_and_frost_senescence",                     &create_mc<thermal_time_and_frost_senescence>},
      {"aba_decay",                                             &create_mc<aba_decay>},
      {"ball_berry",                                            &create_mc<ball_berry>},
+     {"ball_berry_tabulated_swvp",                             &create_mc<ball_berry_tabulated_swvp>},
      {"water_vapor_properties_from_air_temperature",           &create_mc<water_vapor_properties_from_air_temperature>},
+     {"water_vapor_properties_from_air_temperature_tabulated_swvp", &create_mc<water_vapor_properties_from_air_temperature_tabulated_swvp>},
      {"penman_monteith_transpiration",                         &create_mc<penman_monteith_transpiration>},
      {"penman_monteith_leaf_temperature",                      &create_mc<penman_monteith_leaf_temperature>},
      {"priestley_transpiration",                               &create_mc<priestley_transpiration>},
@@ -140,11 +153,26 @@ creator_map standardBML::module_library::library_entries =
      {"c3_leaf_photosynthesis",                                &create_mc<c3_leaf_photosynthesis>},
      {"c4_assimilation",                                       &create_mc<c4_assimilation>},
      {"c4_leaf_photosynthesis",                                &create_mc<c4_leaf_photosynthesis>},
+     {"three_layer_canopy_properties",                         &create_mc<three_layer_canopy_properties>},
+     {"three_layer_rue_canopy",                                &create_mc<three_layer_rue_canopy>},
+     {"three_layer_c3_canopy",                                 &create_mc<three_layer_c3_canopy>},
+     {"three_layer_c4_canopy",                                 &create_mc<three_layer_c4_canopy>},
+     {"three_layer_canopy_integrator",                         &create_mc<three_layer_canopy_integrator>},
+     {"five_layer_canopy_properties",                          &create_mc<five_layer_canopy_properties>},
+     {"five_layer_rue_canopy",                                 &create_mc<five_layer_rue_canopy>},
+     {"five_layer_c3_canopy",                                  &create_mc<five_layer_c3_canopy>},
+     {"five_layer_c4_canopy",                                  &create_mc<five_layer_c4_canopy>},
+     {"five_layer_canopy_integrator",                          &create_mc<five_layer_canopy_integrator>},
      {"ten_layer_canopy_properties",                           &create_mc<ten_layer_canopy_properties>},
      {"ten_layer_rue_canopy",                                  &create_mc<ten_layer_rue_canopy>},
      {"ten_layer_c3_canopy",                                   &create_mc<ten_layer_c3_canopy>},
      {"ten_layer_c4_canopy",                                   &create_mc<ten_layer_c4_canopy>},
      {"ten_layer_canopy_integrator",                           &create_mc<ten_layer_canopy_integrator>},
+     {"twenty_layer_canopy_properties",                        &create_mc<twenty_layer_canopy_properties>},
+     {"twenty_layer_rue_canopy",                               &create_mc<twenty_layer_rue_canopy>},
+     {"twenty_layer_c3_canopy",                                &create_mc<twenty_layer_c3_canopy>},
+     {"twenty_layer_c4_canopy",                                &create_mc<twenty_layer_c4_canopy>},
+     {"twenty_layer_canopy_integrator",                        &create_mc<twenty_layer_canopy_integrator>},
      {"magic_clock",                                           &create_mc<magic_clock>},
      {"poincare_clock",                                        &create_mc<poincare_clock>},
      {"phase_clock",                                           &create_mc<phase_clock>},
@@ -162,11 +190,13 @@ creator_map standardBML::module_library::library_entries =
      {"no_leaf_resp_neg_assim_partitioning_growth_calculator", &create_mc<no_leaf_resp_neg_assim_partitioning_growth_calculator>},
      {"rasmussen_specific_heat",                               &create_mc<rasmussen_specific_heat>},
      {"buck_swvp",                                             &create_mc<buck_swvp>},
+     {"buck_swvp_tabulated",                                   &create_mc<buck_swvp_tabulated>},
      {"rh_to_mole_fraction",                                   &create_mc<rh_to_mole_fraction>},
      {"total_biomass",                                         &create_mc<total_biomass>},
      {"grimm_soybean_flowering",                               &create_mc<grimm_soybean_flowering>},
      {"grimm_soybean_flowering_calculator",                    &create_mc<grimm_soybean_flowering_calculator>},
      {"solar_position_michalsky",                              &create_mc<solar_position_michalsky>},
+     {"solar_position_michalsky_tabulated",                    &create_mc<solar_position_michalsky_tabulated>},
      {"leaf_gbw_thornley",                                     &create_mc<leaf_gbw_thornley>},
      {"leaf_gbw_nikolov",                                      &create_mc<leaf_gbw_nikolov>},
      {"example_model_mass_gain",                               &create_mc<example_model_mass_gain>},
@@ -174,3 +204,38 @@ creator_map standardBML::module_library::library_entries =
      {"litter_cover",                                          &create_mc<litter_cover>},
      {"soil_sunlight",                                         &create_mc<soil_sunlight>}
 };
+
+// Modules whose behavior changes abruptly when a smoothly-varying quantity
+// crosses a threshold; see `switching_functions.h` for more details.
+switching_function_map standardBML::module_library::switching_entries =
+{
+     {"partitioning_coefficient_selector", {
+         {"TTc", {}, 0.0},
+         {"TTc", {"tp1"}, 0.0},
+         {"TTc", {"tp2"}, 0.0},
+         {"TTc", {"tp3"}, 0.0},
+         {"TTc", {"tp4"}, 0.0},
+         {"TTc", {"tp5"}, 0.0}}},
+     {"soybean_development_rate_calculator", {
+         {"time", {"sowing_time"}, 0.0},
+         {"DVI", {}, -1.0},
+         {"DVI", {}, 0.0},
+         {"DVI", {}, 0.333},
+         {"DVI", {}, 0.667},
+         {"DVI", {}, 1.0}}},
+     {"grimm_soybean_flowering_calculator", {
+         {"time", {"sowing_time"}, 0.0},
+         {"grimm_physiological_age", {"grimm_juvenile_pd_threshold"}, 0.0},
+         {"grimm_physiological_age", {"grimm_juvenile_pd_threshold", "grimm_flowering_threshold"}, 0.0}}}
+};
+
+// Modules whose outputs depend on the inputs they received in earlier calls
+// to `run()`, as well as on their current inputs. A system containing any of
+// these modules must be created again whenever its derivatives are calculated
+// at an arbitrary state and time, as they are by the solvers in the deSolve R
+// package; see `system_derivatives` in the R package.
+string_vector standardBML::module_library::history_dependent_entries =
+{
+     "thermal_time_senescence",
+     "thermal_time_and_frost_senescence"
+};
@@ -2,6 +2,7 @@
 #define STANDARDBML_H
 
 #include "../framework/module_creator.h"  // for module_creator and creator_map
+#include "switching_functions.h"          // for switching_function_map
 
 // When creating a new module library R package, it will be necessary to modify
 // the header guard and the namespace name in this file to reflect the new
@@ -20,6 +21,8 @@ class module_library
 {
    public:
     static creator_map library_entries;
+    static switching_function_map switching_entries;
+    static string_vector history_dependent_entries;
 };
 
 }  // namespace standardBML
@@ -8,53 +8,73 @@
 
 namespace standardBML
 {
-using ten_layer_c4_canopy_parent =
+template <int number_of_layers>
+using n_layer_c4_canopy_parent =
     multilayer_canopy_photosynthesis<
-        ten_layer_canopy_properties,
+        n_layer_canopy_properties<number_of_layers>,
         c4_leaf_photosynthesis>;
 
 /**
- * @class ten_layer_c4_canopy
+ * @class n_layer_c4_canopy
  *
- * @brief Represents a ten layer canopy where leaf-level photosynthesis is
- * calculated using the Collatz et al. model for C4 photosynthesis; see the
+ * @brief Represents a canopy with a fixed number of layers where leaf-level
+ * photosynthesis is calculated using the Collatz et al. model for C4 photosynthesis; see the
  * `c4_leaf_photosynthesis` class for more information about this model.
  *
  * More specifically, this is a child class of
  * `multilayer_canopy_photosynthesis` where:
  *
- *  - The canopy module is set to the `ten_layer_canopy_properties` module
+ *  - The canopy module is set to the `n_layer_canopy_properties` module with
+ *    the same number of layers
  *
  *  - The leaf module is set to the `c4_leaf_photosynthesis` module
  *
- *  - The number of layers is set to 10
+ *  - The number of layers is set by the template parameter
+ *
+ * The module name is formed from the number of layers (see
+ * `layer_count_name`); e.g., `n_layer_c4_canopy<10>` is the
+ * `ten_layer_c4_canopy` module.
  *
  * Instances of this class can be created using the module factory, unlike the
  * parent class `multilayer_canopy_photosynthesis`.
  */
-class ten_layer_c4_canopy : public ten_layer_c4_canopy_parent
+template <int number_of_layers>
+class n_layer_c4_canopy : public n_layer_c4_canopy_parent<number_of_layers>
 {
+    using parent = n_layer_c4_canopy_parent<number_of_layers>;
+
    public:
-    ten_layer_c4_canopy(
+    n_layer_c4_canopy(
         state_map const& input_quantities,
         state_map* output_quantities)
-        : ten_layer_c4_canopy_parent(
-              ten_layer_c4_canopy::nlayers,
+        : parent(
+              number_of_layers,
               input_quantities,
               output_quantities)
     {
     }
-    static string_vector get_inputs();
-    static string_vector get_outputs();
-    static std::string get_name() { return "ten_layer_c4_canopy"; }
+    static string_vector get_inputs()
+    {
+        return parent::generate_inputs(number_of_layers);
+    }
+    static string_vector get_outputs()
+    {
+        return parent::generate_outputs(number_of_layers);
+    }
+    static std::string get_name()
+    {
+        return layer_count_name<number_of_layers>::get() + "_layer_c4_canopy";
+    }
 
    private:
-    // Number of layers
-    int static const nlayers;
-
     // Main operation
-    void do_operation() const;
+    void do_operation() const { parent::run(); }
 };
 
+using three_layer_c4_canopy = n_layer_c4_canopy<3>;
+using five_layer_c4_canopy = n_layer_c4_canopy<5>;
+using ten_layer_c4_canopy = n_layer_c4_canopy<10>;
+using twenty_layer_c4_canopy = n_layer_c4_canopy<20>;
+
 }  // namespace standardBML
 #endif
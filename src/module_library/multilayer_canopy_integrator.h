@@ -4,6 +4,7 @@
 #include "../framework/state_map.h"
 #include "../framework/module.h"
 #include "../framework/constants.h"  // for molar_mass_of_water, molar_mass_of_glucose
+#include "layer_count_names.h"
 
 namespace standardBML
 {
@@ -214,62 +215,57 @@ void multilayer_canopy_integrator::run() const
     update(canopy_conductance_op, canopy_conductance);
 }
 
-////////////////////////////////////////
-// TEN LAYER CANOPY INTEGRATOR MODULE //
-////////////////////////////////////////
+///////////////////////////////////////
+// N LAYER CANOPY INTEGRATOR MODULES //
+///////////////////////////////////////
 
 /**
- * @class ten_layer_canopy_integrator
+ * @class n_layer_canopy_integrator
  *
  * @brief A child class of multilayer_canopy_integrator where the number of
- * layers has been defined. Instances of this class can be created using the
- * module factory, unlike the parent class `multilayer_canopy_integrator`.
+ * layers has been fixed by the template parameter. Instances of this class can
+ * be created using the module factory, unlike the parent class
+ * `multilayer_canopy_integrator`.
+ *
+ * The module name is formed from the number of layers (see
+ * `layer_count_name`); e.g., `n_layer_canopy_integrator<10>` is the
+ * `ten_layer_canopy_integrator` module.
  */
-class ten_layer_canopy_integrator : public multilayer_canopy_integrator
+template <int number_of_layers>
+class n_layer_canopy_integrator : public multilayer_canopy_integrator
 {
    public:
-    ten_layer_canopy_integrator(
+    n_layer_canopy_integrator(
         state_map const& input_quantities,
         state_map* output_quantities)
         : multilayer_canopy_integrator(
-              ten_layer_canopy_integrator::nlayers,
+              number_of_layers,
               input_quantities,
               output_quantities)
     {
     }
-    static string_vector get_inputs();
-    static string_vector get_leaf_classes();
-    static string_vector get_multiclass_multilayer_outputs();
-    static string_vector get_pure_multilayer_outputs();
-    static string_vector get_outputs();
-    static std::string get_name() { return "ten_layer_canopy_integrator"; }
+    static string_vector get_inputs()
+    {
+        return multilayer_canopy_integrator::get_inputs(number_of_layers);
+    }
+    static string_vector get_outputs()
+    {
+        return multilayer_canopy_integrator::get_outputs(number_of_layers);
+    }
+    static std::string get_name()
+    {
+        return layer_count_name<number_of_layers>::get() + "_layer_canopy_integrator";
+    }
 
    private:
-    // Number of layers
-    int static const nlayers;
-
     // Main operation
-    void do_operation() const;
+    void do_operation() const { multilayer_canopy_integrator::run(); }
 };
 
-int const ten_layer_canopy_integrator::nlayers = 10;
-
-string_vector ten_layer_canopy_integrator::get_inputs()
-{
-    return multilayer_canopy_integrator::get_inputs(
-        ten_layer_canopy_integrator::nlayers);
-}
-
-string_vector ten_layer_canopy_integrator::get_outputs()
-{
-    return multilayer_canopy_integrator::get_outputs(
-        ten_layer_canopy_integrator::nlayers);
-}
-
-void ten_layer_canopy_integrator::do_operation() const
-{
-    multilayer_canopy_integrator::run();
-}
+using three_layer_canopy_integrator = n_layer_canopy_integrator<3>;
+using five_layer_canopy_integrator = n_layer_canopy_integrator<5>;
+using ten_layer_canopy_integrator = n_layer_canopy_integrator<10>;
+using twenty_layer_canopy_integrator = n_layer_canopy_integrator<20>;
 
 }  // namespace standardBML
 #endif
@@ -1,9 +1,12 @@
 #ifndef MULTILAYER_CANOPY_PHOTOSYNTHESIS_H
 #define MULTILAYER_CANOPY_PHOTOSYNTHESIS_H
 
-#include <algorithm>  // for std::find
+#include <algorithm>    // for std::find
+#include <type_traits>  // for std::true_type, std::false_type
+#include <utility>      // for std::declval
 #include "../framework/module.h"
 #include "../framework/state_map.h"
+#include "kernel_fields.h"  // for get_kernel_fields
 
 namespace MLCP  // helping functions for the MultiLayer Canopy Photosynthesis module
 {
@@ -92,6 +95,45 @@ string_vector get_other_leaf_inputs()
 
     return leaf_inputs_constant_through_canopy;
 }
+
+/**
+ * @brief Determines whether a leaf module type has a static `kernel()` method
+ * that takes a `kernel_inputs` struct and returns a `kernel_outputs` struct.
+ * Such a module must also have `kernel_input_fields()` and
+ * `kernel_output_fields()` methods that name the quantity held by each field of
+ * those structs (see `kernel_field_list`).
+ */
+template <typename leaf_module_type, typename = void>
+struct has_static_kernel : std::false_type {
+};
+
+template <typename leaf_module_type>
+struct has_static_kernel<
+    leaf_module_type,
+    decltype(void(leaf_module_type::kernel(
+        std::declval<typename leaf_module_type::kernel_inputs const&>())))>
+    : std::true_type {
+};
+
+/**
+ * @brief Provides the input and output structs used by the static `kernel()`
+ * method of a leaf module type, or empty placeholder structs if it has none.
+ */
+template <
+    typename leaf_module_type,
+    bool = has_static_kernel<leaf_module_type>::value>
+struct leaf_kernel_types {
+    struct kernel_inputs {
+    };
+    struct kernel_outputs {
+    };
+};
+
+template <typename leaf_module_type>
+struct leaf_kernel_types<leaf_module_type, true> {
+    using kernel_inputs = typename leaf_module_type::kernel_inputs;
+    using kernel_outputs = typename leaf_module_type::kernel_outputs;
+};
 }  // namespace MLCP
 
 namespace standardBML
@@ -148,6 +190,23 @@ namespace standardBML
  * base name (e.g. `incident_par`), a prefix that indicates the leaf class (e.g.
  * `sunlit_`), and a suffix that indicates the layer number (e.g. `_layer_0`).
  *
+ * ### Leaf modules with static kernels
+ *
+ * If the leaf module type has a static `kernel()` method (see
+ * `MLCP::has_static_kernel`), the field of its `kernel_inputs` struct that
+ * corresponds to each leaf module input is found by name when this module is
+ * constructed. During each call to `run()`, the inputs that do not change with
+ * leaf class or canopy layer are read once, and a contiguous array holding one
+ * `kernel_inputs` struct for each leaf class and layer is filled from them and
+ * from the layer- and class-dependent quantities. The kernel is then called for
+ * each element of the array, and the fields of each `kernel_outputs` struct are
+ * written to the corresponding canopy outputs.
+ *
+ * Otherwise, a single leaf module object is created, and the inputs and outputs
+ * for each leaf class and layer are copied to and from its private `state_map`.
+ * Both approaches produce the same output quantities, but the first reads the
+ * shared inputs only once and avoids a virtual function call for each leaf.
+ *
  * Note that this module has a non-standard constructor, so it cannot be created
  * using the module_factory. Rather, it is expected that directly-usable
  * classes will be derived from this class.
@@ -176,6 +235,45 @@ class multilayer_canopy_photosynthesis : public direct_module
     // Pointers to output parameters
     std::vector<std::vector<std::pair<double*, const double*>>> leaf_output_ptr_pairs;
 
+    // Types used when the leaf module has a static kernel
+    using use_kernel = MLCP::has_static_kernel<leaf_module_type>;
+    using kernel_inputs = typename MLCP::leaf_kernel_types<leaf_module_type>::kernel_inputs;
+    using kernel_outputs = typename MLCP::leaf_kernel_types<leaf_module_type>::kernel_outputs;
+
+    // Pairs of kernel input fields and pointers to the canopy input quantities
+    // that do not change with leaf class or canopy layer
+    std::vector<std::pair<double kernel_inputs::*, const double*>> shared_kernel_input_sources;
+
+    // Pairs of kernel input fields and pointers to the canopy input quantities
+    // that change with leaf class or canopy layer, stored contiguously for each
+    // leaf class and layer
+    size_t n_layered_kernel_inputs{0};
+    std::vector<std::pair<double kernel_inputs::*, const double*>> layered_kernel_input_sources;
+
+    // Kernel output fields, in the same order as `get_outputs()` for the leaf
+    // module, and pointers to the canopy output quantities for each leaf class
+    // and layer, stored contiguously for each leaf class and layer
+    std::vector<double kernel_outputs::*> kernel_output_fields;
+    std::vector<double*> kernel_output_ptrs;
+
+    // Kernel inputs for each leaf class and layer, which are filled during
+    // each call to `run()`
+    kernel_inputs mutable shared_kernel_inputs{};
+    std::vector<kernel_inputs> mutable leaf_kernel_inputs;
+
+    void connect_leaves(
+        std::true_type,
+        state_map const& input_quantities,
+        state_map* output_quantities);
+
+    void connect_leaves(
+        std::false_type,
+        state_map const& input_quantities,
+        state_map* output_quantities);
+
+    void run_leaves(std::true_type) const;
+    void run_leaves(std::false_type) const;
+
    protected:
     static string_vector generate_inputs(int nlayers);
     static string_vector generate_outputs(int nlayers);
@@ -194,6 +292,103 @@ multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::multilay
     state_map* output_quantities)
     : direct_module{},
       nlayers(nlayers)
+{
+    connect_leaves(use_kernel{}, input_quantities, output_quantities);
+}
+
+/**
+ * @brief Finds the `kernel_inputs` and `kernel_outputs` fields corresponding to
+ * each leaf module input and output, and stores them along with pointers to the
+ * canopy quantities for each leaf class and layer.
+ */
+template <typename canopy_module_type, typename leaf_module_type>
+void multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::connect_leaves(
+    std::true_type,
+    state_map const& input_quantities,
+    state_map* output_quantities)
+{
+    // Find subsets of the leaf model's inputs
+    string_vector multiclass_multilayer_leaf_inputs =
+        MLCP::get_multiclass_multilayer_leaf_inputs<canopy_module_type, leaf_module_type>();
+
+    string_vector multilayer_leaf_inputs =
+        MLCP::get_pure_multilayer_leaf_inputs<canopy_module_type, leaf_module_type>();
+
+    string_vector other_leaf_inputs =
+        MLCP::get_other_leaf_inputs<canopy_module_type, leaf_module_type>();
+
+    // Find the kernel fields for each input and output; this throws an
+    // exception if the kernel does not have a field for each quantity
+    std::vector<double kernel_inputs::*> const input_fields =
+        get_kernel_fields(
+            leaf_module_type::kernel_input_fields(),
+            leaf_module_type::get_inputs());
+
+    kernel_output_fields =
+        get_kernel_fields(
+            leaf_module_type::kernel_output_fields(),
+            leaf_module_type::get_outputs());
+
+    string_vector const leaf_inputs = leaf_module_type::get_inputs();
+
+    auto field_for = [&](std::string const& name) {
+        return input_fields[std::find(leaf_inputs.begin(), leaf_inputs.end(), name) -
+                            leaf_inputs.begin()];
+    };
+
+    // Get pointers to the inputs that are the same for all leaf classes and
+    // layers
+    for (std::string const& name : other_leaf_inputs) {
+        shared_kernel_input_sources.push_back(
+            {field_for(name), get_ip(input_quantities, name)});
+    }
+
+    // Get pointers to the inputs and outputs for each leaf class and layer
+    n_layered_kernel_inputs =
+        multiclass_multilayer_leaf_inputs.size() + multilayer_leaf_inputs.size();
+
+    for (std::string const& class_name : canopy_module_type::define_leaf_classes()) {
+        for (int i = 0; i < nlayers; ++i) {
+            for (std::string const& name : multiclass_multilayer_leaf_inputs) {
+                std::string specific_name =
+                    add_class_prefix_to_quantity_name(
+                        class_name,
+                        add_layer_suffix_to_quantity_name(nlayers, i, name));
+
+                layered_kernel_input_sources.push_back(
+                    {field_for(name), get_ip(input_quantities, specific_name)});
+            }
+
+            for (std::string const& name : multilayer_leaf_inputs) {
+                std::string specific_name =
+                    add_layer_suffix_to_quantity_name(nlayers, i, name);
+
+                layered_kernel_input_sources.push_back(
+                    {field_for(name), get_ip(input_quantities, specific_name)});
+            }
+
+            for (std::string const& name : leaf_module_type::get_outputs()) {
+                kernel_output_ptrs.push_back(get_op(
+                    output_quantities,
+                    add_class_prefix_to_quantity_name(
+                        class_name,
+                        add_layer_suffix_to_quantity_name(nlayers, i, name))));
+            }
+
+            leaf_kernel_inputs.push_back(kernel_inputs{});
+        }
+    }
+}
+
+/**
+ * @brief Creates the leaf module and prepares to pass inputs to it from the
+ * canopy module.
+ */
+template <typename canopy_module_type, typename leaf_module_type>
+void multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::connect_leaves(
+    std::false_type,
+    state_map const& input_quantities,
+    state_map* output_quantities)
 {
     // Define a lambda for making quantity maps from vectors of inputs and outputs
     auto make_quantity_map = [](string_vector input_names, string_vector output_names) -> state_map {
@@ -206,6 +401,16 @@ multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::multilay
         return result;
     };
 
+    // Find subsets of the leaf model's inputs
+    string_vector multiclass_multilayer_leaf_inputs =
+        MLCP::get_multiclass_multilayer_leaf_inputs<canopy_module_type, leaf_module_type>();
+
+    string_vector multilayer_leaf_inputs =
+        MLCP::get_pure_multilayer_leaf_inputs<canopy_module_type, leaf_module_type>();
+
+    string_vector other_leaf_inputs =
+        MLCP::get_other_leaf_inputs<canopy_module_type, leaf_module_type>();
+
     // Form a quantity state_map to pass to the leaf photosynthesis module
     leaf_module_quantities =
         make_quantity_map(
@@ -220,16 +425,6 @@ multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::multilay
             leaf_module_quantities,
             &leaf_module_output_map));
 
-    // Find subsets of the leaf model's inputs
-    string_vector multiclass_multilayer_leaf_inputs =
-        MLCP::get_multiclass_multilayer_leaf_inputs<canopy_module_type, leaf_module_type>();
-
-    string_vector multilayer_leaf_inputs =
-        MLCP::get_pure_multilayer_leaf_inputs<canopy_module_type, leaf_module_type>();
-
-    string_vector other_leaf_inputs =
-        MLCP::get_other_leaf_inputs<canopy_module_type, leaf_module_type>();
-
     // Create vectors of pointer pairs which will be used for passing inputs to
     // and getting outputs from the leaf module
     for (std::string const& class_name : canopy_module_type::define_leaf_classes()) {
@@ -336,6 +531,47 @@ string_vector multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_t
 
 template <typename canopy_module_type, typename leaf_module_type>
 void multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::run() const
+{
+    run_leaves(use_kernel{});
+}
+
+template <typename canopy_module_type, typename leaf_module_type>
+void multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::run_leaves(std::true_type) const
+{
+    size_t const n_leaf_outputs = kernel_output_fields.size();
+
+    // Fill the kernel inputs that are the same for all leaf classes and layers
+    for (auto const& x : shared_kernel_input_sources) {
+        shared_kernel_inputs.*x.first = *x.second;
+    }
+
+    // Fill the kernel inputs for each combination of leaf class and layer
+    // number, starting from the shared inputs
+    for (size_t i = 0; i < leaf_kernel_inputs.size(); ++i) {
+        kernel_inputs& leaf_inputs = leaf_kernel_inputs[i];
+        leaf_inputs = shared_kernel_inputs;
+
+        for (size_t j = 0; j < n_layered_kernel_inputs; ++j) {
+            auto const& x = layered_kernel_input_sources[i * n_layered_kernel_inputs + j];
+            leaf_inputs.*x.first = *x.second;
+        }
+    }
+
+    // Run the kernel for each combination of leaf class and layer number, and
+    // update its outputs
+    for (size_t i = 0; i < leaf_kernel_inputs.size(); ++i) {
+        kernel_outputs const leaf_outputs =
+            leaf_module_type::kernel(leaf_kernel_inputs[i]);
+
+        for (size_t j = 0; j < n_leaf_outputs; ++j) {
+            *kernel_output_ptrs[i * n_leaf_outputs + j] =
+                leaf_outputs.*kernel_output_fields[j];
+        }
+    }
+}
+
+template <typename canopy_module_type, typename leaf_module_type>
+void multilayer_canopy_photosynthesis<canopy_module_type, leaf_module_type>::run_leaves(std::false_type) const
 {
     // For each combination of leaf class and layer number:
     for (size_t i = 0; i < leaf_input_ptr_pairs.size(); ++i) {
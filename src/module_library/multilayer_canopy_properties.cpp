@@ -4,7 +4,6 @@
 #include "sunML.h"      // for sunML
 
 using standardBML::multilayer_canopy_properties;
-using standardBML::ten_layer_canopy_properties;
 
 /**
  * @brief Define all inputs required by the module
@@ -106,7 +105,8 @@ void multilayer_canopy_properties::run() const
     // that the `sunML` function expects input expects PPFD values, so we must
     // convert photosynthetically active radiation (PAR) to PPFD using the
     // energy content of light in the PAR band
-    struct Light_profile light_profile = sunML(
+    Light_profile& light_profile = profile_buffers.light_profile;
+    sunML(
         par_incident_direct / par_energy_content,   // micromol / (m^2 beam) / s
         par_incident_diffuse / par_energy_content,  // micromol / m^2 / s
         lai,
@@ -119,15 +119,16 @@ void multilayer_canopy_properties::run() const
         par_energy_content,
         par_energy_fraction,
         leaf_transmittance,
-        leaf_reflectance);
+        leaf_reflectance,
+        light_profile);
 
     // Calculate windspeed throughout the canopy
-    double wind_speed_profile[nlayers];
-    WINDprof(windspeed, lai, nlayers, wind_speed_profile);  // Modifies wind_speed_profile
+    std::vector<double>& wind_speed_profile = profile_buffers.wind_speed_profile;
+    WINDprof(windspeed, lai, nlayers, wind_speed_profile.data());  // Modifies wind_speed_profile
 
     // Calculate leaf nitrogen throughout the canopy
-    double leafN_profile[nlayers];
-    LNprof(LeafN, lai, nlayers, kpLN, leafN_profile);  // Modifies leafN_profile
+    std::vector<double>& leafN_profile = profile_buffers.leafN_profile;
+    LNprof(LeafN, lai, nlayers, kpLN, leafN_profile.data());  // Modifies leafN_profile
 
     // Don't calculate anything based on the nitrogen profile
     if (lnfun != 0) {
@@ -158,41 +159,3 @@ void multilayer_canopy_properties::run() const
     // Update other outputs
     update(canopy_direct_transmission_fraction_op, light_profile.canopy_direct_transmission_fraction);
 }
-
-////////////////////////////////////////
-// TEN LAYER CANOPY PROPERTIES MODULE //
-////////////////////////////////////////
-
-int const ten_layer_canopy_properties::nlayers = 10;
-
-string_vector ten_layer_canopy_properties::get_inputs()
-{
-    return multilayer_canopy_properties::get_inputs(ten_layer_canopy_properties::nlayers);
-}
-
-string_vector ten_layer_canopy_properties::define_leaf_classes()
-{
-    return multilayer_canopy_properties::define_leaf_classes();
-}
-
-string_vector ten_layer_canopy_properties::define_multiclass_multilayer_outputs()
-{
-    // Just call the parent class's multilayer output function
-    return multilayer_canopy_properties::define_multiclass_multilayer_outputs();
-}
-
-string_vector ten_layer_canopy_properties::define_pure_multilayer_outputs()
-{
-    // Just call the parent class's multilayer output function
-    return multilayer_canopy_properties::define_pure_multilayer_outputs();
-}
-
-string_vector ten_layer_canopy_properties::get_outputs()
-{
-    return multilayer_canopy_properties::get_outputs(ten_layer_canopy_properties::nlayers);
-}
-
-void ten_layer_canopy_properties::do_operation() const
-{
-    multilayer_canopy_properties::run();
-}
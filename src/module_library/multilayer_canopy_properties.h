@@ -3,6 +3,8 @@
 
 #include "../framework/state_map.h"
 #include "../framework/module.h"
+#include "layer_count_names.h"
+#include "canopy_profile_buffers.h"  // for canopy_profile_buffers
 
 namespace standardBML
 {
@@ -95,7 +97,10 @@ class multilayer_canopy_properties : public direct_module
           height_ops{get_multilayer_op(output_quantities, nlayers, "height")},
           windspeed_ops{get_multilayer_op(output_quantities, nlayers, "windspeed")},
           LeafN_ops{get_multilayer_op(output_quantities, nlayers, "LeafN")},
-          canopy_direct_transmission_fraction_op{get_op(output_quantities, "canopy_direct_transmission_fraction")}
+          canopy_direct_transmission_fraction_op{get_op(output_quantities, "canopy_direct_transmission_fraction")},
+
+          // Allocate storage for the canopy profiles
+          profile_buffers{nlayers}
     {
     }
 
@@ -138,6 +143,9 @@ class multilayer_canopy_properties : public direct_module
     std::vector<double*> const LeafN_ops;
     double* canopy_direct_transmission_fraction_op;
 
+    // Storage for the canopy profiles, reused every time the module runs
+    canopy_profile_buffers mutable profile_buffers;
+
    protected:
     void run() const;
     static string_vector get_inputs(int nlayers);
@@ -147,43 +155,69 @@ class multilayer_canopy_properties : public direct_module
     static string_vector get_outputs(int nlayers);
 };
 
-////////////////////////////////////////
-// TEN LAYER CANOPY PROPERTIES MODULE //
-////////////////////////////////////////
+///////////////////////////////////////
+// N LAYER CANOPY PROPERTIES MODULES //
+///////////////////////////////////////
 
 /**
- * @class ten_layer_canopy_properties
+ * @class n_layer_canopy_properties
  *
  * @brief A child class of multilayer_canopy_properties where the number of
- * layers has been defined. Instances of this class can be created using the
- * module factory, unlike the parent class `multilayer_canopy_properties`.
+ * layers has been fixed by the template parameter. Instances of this class can
+ * be created using the module factory, unlike the parent class
+ * `multilayer_canopy_properties`.
+ *
+ * The module name is formed from the number of layers (see
+ * `layer_count_name`); e.g., `n_layer_canopy_properties<10>` is the
+ * `ten_layer_canopy_properties` module.
  */
-class ten_layer_canopy_properties : public multilayer_canopy_properties
+template <int number_of_layers>
+class n_layer_canopy_properties : public multilayer_canopy_properties
 {
    public:
-    ten_layer_canopy_properties(
+    n_layer_canopy_properties(
         state_map const& input_quantities,
         state_map* output_quantities)
         : multilayer_canopy_properties(
-              ten_layer_canopy_properties::nlayers,
+              number_of_layers,
               input_quantities,
               output_quantities)
     {
     }
-    static string_vector get_inputs();
-    static string_vector define_leaf_classes();
-    static string_vector define_multiclass_multilayer_outputs();
-    static string_vector define_pure_multilayer_outputs();
-    static string_vector get_outputs();
-    static std::string get_name() { return "ten_layer_canopy_properties"; }
+    static string_vector get_inputs()
+    {
+        return multilayer_canopy_properties::get_inputs(number_of_layers);
+    }
+    static string_vector define_leaf_classes()
+    {
+        return multilayer_canopy_properties::define_leaf_classes();
+    }
+    static string_vector define_multiclass_multilayer_outputs()
+    {
+        return multilayer_canopy_properties::define_multiclass_multilayer_outputs();
+    }
+    static string_vector define_pure_multilayer_outputs()
+    {
+        return multilayer_canopy_properties::define_pure_multilayer_outputs();
+    }
+    static string_vector get_outputs()
+    {
+        return multilayer_canopy_properties::get_outputs(number_of_layers);
+    }
+    static std::string get_name()
+    {
+        return layer_count_name<number_of_layers>::get() + "_layer_canopy_properties";
+    }
 
    private:
-    // Number of layers
-    int static const nlayers;
-
     // Main operation
-    void do_operation() const;
+    void do_operation() const { multilayer_canopy_properties::run(); }
 };
 
+using three_layer_canopy_properties = n_layer_canopy_properties<3>;
+using five_layer_canopy_properties = n_layer_canopy_properties<5>;
+using ten_layer_canopy_properties = n_layer_canopy_properties<10>;
+using twenty_layer_canopy_properties = n_layer_canopy_properties<20>;
+
 }  // namespace standardBML
 #endif
@@ -0,0 +1,190 @@
+#include <algorithm>  // for std::min, std::max
+#include <cmath>      // for pow
+#include "multilayer_soil_water.h"
+
+using standardBML::multilayer_soil_water;
+
+namespace
+{
+/**
+ * @brief Solves a tridiagonal system of linear equations using the Thomas
+ * algorithm, overwriting `rhs` with the solution and `super_diagonal` with
+ * intermediate values.
+ *
+ * Row `i` of the system is
+ *
+ * `sub_diagonal[i] * x[i - 1] + diagonal[i] * x[i] + super_diagonal[i] * x[i + 1] = rhs[i]`
+ *
+ * where `sub_diagonal[0]` and `super_diagonal[n - 1]` are not used. The matrix
+ * must be diagonally dominant (by rows or columns) so that no pivoting is
+ * required.
+ */
+void solve_tridiagonal(
+    std::vector<double> const& sub_diagonal,
+    std::vector<double> const& diagonal,
+    std::vector<double>& super_diagonal,
+    std::vector<double>& rhs)
+{
+    size_t const n = diagonal.size();
+
+    // Forward elimination
+    double denominator = diagonal[0];
+    super_diagonal[0] /= denominator;
+    rhs[0] /= denominator;
+
+    for (size_t i = 1; i < n; ++i) {
+        denominator = diagonal[i] - sub_diagonal[i] * super_diagonal[i - 1];
+        super_diagonal[i] /= denominator;
+        rhs[i] = (rhs[i] - sub_diagonal[i] * rhs[i - 1]) / denominator;
+    }
+
+    // Back substitution
+    for (size_t i = n - 1; i > 0; --i) {
+        rhs[i - 1] -= super_diagonal[i - 1] * rhs[i];
+    }
+}
+}  // namespace
+
+/**
+ * @brief Define all inputs required by the module
+ */
+string_vector multilayer_soil_water::get_inputs(int nlayers)
+{
+    // Add layer number suffixes to the water content of each layer
+    string_vector inputs = generate_multilayer_quantity_names(
+        nlayers, {"soil_water_content"});  // dimensionless (m^3 / m^3)
+
+    // Include inputs that do not depend on the number of layers
+    string_vector const other_inputs = {
+        "soil_water_content",           // dimensionless (m^3 / m^3)
+        "soil_depth",                   // m
+        "soil_saturation_capacity",     // dimensionless (m^3 / m^3)
+        "soil_wilting_point",           // dimensionless (m^3 / m^3)
+        "soil_saturated_conductivity",  // kg * s / m^3
+        "soil_air_entry",               // J / kg
+        "soil_b_coefficient",           // dimensionless
+        "acceleration_from_gravity",    // m / s^2
+        "precipitation_rate",           // m / s
+        "canopy_transpiration_rate",    // Mg / ha / hr
+        "soil_evaporation_rate",        // Mg / ha / hr
+        "timestep"                      // hr
+    };
+
+    inputs.insert(inputs.end(), other_inputs.begin(), other_inputs.end());
+
+    return inputs;
+}
+
+/**
+ * @brief Define all outputs produced by the module
+ */
+string_vector multilayer_soil_water::get_outputs(int nlayers)
+{
+    string_vector outputs = generate_multilayer_quantity_names(
+        nlayers, {"soil_water_content"});  // hr^-1
+
+    outputs.push_back("soil_water_content");  // hr^-1
+
+    return outputs;
+}
+
+void multilayer_soil_water::run() const
+{
+    constexpr double density_of_water_at_20_celcius = 998.2;  // kg / m^3
+    constexpr double seconds_per_hour = 3600.0;               // s / hr
+    constexpr double mg_per_ha_to_kg_per_m2 = 1e3 / 1e4;      // (kg / m^2) / (Mg / ha)
+    constexpr int implicit_iterations = 4;
+
+    double const layer_thickness = soil_depth / nlayers;  // m
+    double const dt = timestep * seconds_per_hour;        // s
+
+    // Mass of water per unit area and time needed to change the water content
+    // of one layer by 1 over one time step
+    double const layer_capacity =
+        density_of_water_at_20_celcius * layer_thickness / dt;  // kg / m^2 / s
+
+    // Water entering the top of the profile and removed from each layer by
+    // roots (both in kg / m^2 / s)
+    double const infiltration =
+        density_of_water_at_20_celcius * precipitation_rate -
+        soil_evaporation_rate * mg_per_ha_to_kg_per_m2 / seconds_per_hour;
+
+    double const uptake_per_layer =
+        canopy_transpiration_rate * mg_per_ha_to_kg_per_m2 / seconds_per_hour / nlayers;
+
+    for (int i = 0; i < nlayers; ++i) {
+        theta[i] = *soil_water_content_layer_ips[i];
+        new_theta[i] = std::min(
+            std::max(theta[i], soil_wilting_point),
+            soil_saturation_capacity);
+    }
+
+    // Find the new water contents by solving the implicit equations with a
+    // fixed number of iterations, so that the outputs are smooth functions of
+    // the inputs
+    for (int iteration = 0; iteration < implicit_iterations; ++iteration) {
+        // Determine the matric potential, conductivity, and sensitivity of the
+        // matric potential to water content in each layer at the current
+        // estimate of the new water contents
+        for (int i = 0; i < nlayers; ++i) {
+            double const relative_saturation = new_theta[i] / soil_saturation_capacity;
+
+            potential[i] = soil_air_entry * pow(relative_saturation, -soil_b_coefficient);
+            conductivity[i] = soil_saturated_conductivity *
+                              pow(relative_saturation, 2 * soil_b_coefficient + 3);
+            dpsi_dtheta[i] = -soil_b_coefficient * potential[i] / new_theta[i];
+        }
+
+        // Form the tridiagonal system for the corrections to the water
+        // contents. Here `flux_above` and `conductance_above` describe the
+        // interface between layer `i` and the layer above it, which for the
+        // top layer is the surface.
+        double flux_above = infiltration;  // kg / m^2 / s
+        double conductance_above = 0.0;    // kg * s / m^4
+
+        for (int i = 0; i < nlayers; ++i) {
+            double flux_below;         // kg / m^2 / s
+            double conductance_below;  // kg * s / m^4
+
+            if (i < nlayers - 1) {
+                double const mean_conductivity = 0.5 * (conductivity[i] + conductivity[i + 1]);
+                conductance_below = mean_conductivity / layer_thickness;
+                flux_below = conductance_below * (potential[i] - potential[i + 1]) +
+                             mean_conductivity * acceleration_from_gravity;
+            } else {
+                // Free drainage from the bottom of the profile
+                conductance_below = 0.0;
+                flux_below = conductivity[i] * acceleration_from_gravity;
+            }
+
+            sub_diagonal[i] = i > 0 ? -conductance_above * dpsi_dtheta[i - 1] : 0.0;
+            diagonal[i] = layer_capacity + dpsi_dtheta[i] * (conductance_above + conductance_below);
+            super_diagonal[i] = i < nlayers - 1 ? -conductance_below * dpsi_dtheta[i + 1] : 0.0;
+            rhs[i] = flux_above - flux_below - uptake_per_layer -
+                     layer_capacity * (new_theta[i] - theta[i]);
+
+            flux_above = flux_below;
+            conductance_above = conductance_below;
+        }
+
+        // Solve for the corrections (stored in `rhs`) and apply them, limiting
+        // the new water contents to the allowed range
+        solve_tridiagonal(sub_diagonal, diagonal, super_diagonal, rhs);
+
+        for (int i = 0; i < nlayers; ++i) {
+            new_theta[i] = std::min(
+                std::max(new_theta[i] + rhs[i], soil_wilting_point),
+                soil_saturation_capacity);
+        }
+    }
+
+    // Update the output quantity list
+    double new_mean_water_content = 0.0;
+    for (int i = 0; i < nlayers; ++i) {
+        new_mean_water_content += new_theta[i] / nlayers;
+
+        update(soil_water_content_layer_ops[i], (new_theta[i] - theta[i]) / timestep);
+    }
+
+    update(soil_water_content_op, (new_mean_water_content - soil_water_content) / timestep);
+}
@@ -0,0 +1,205 @@
+#ifndef MULTILAYER_SOIL_WATER_H
+#define MULTILAYER_SOIL_WATER_H
+
+#include <vector>
+#include "../framework/state_map.h"
+#include "../framework/module.h"
+#include "layer_count_names.h"
+
+namespace standardBML
+{
+/**
+ * @class multilayer_soil_water
+ *
+ * @brief Calculates the movement of water through a soil profile divided into
+ * layers of equal thickness, using an implicit update so that sharp
+ * wetting fronts do not force an ODE solver to take very small steps.
+ *
+ * ### Model overview
+ *
+ * The matric potential `psi` and hydraulic conductivity `K` of each layer are
+ * determined from its volumetric water content `theta` following Campbell and
+ * Norman, "An Introduction to Environmental Biophysics" (1998), Chapter 9:
+ *
+ * > `psi = psi_e * (theta / theta_s)^(-b)`
+ * >
+ * > `K = K_s * (theta / theta_s)^(2 * b + 3)`
+ *
+ * where `psi_e` is the air entry potential, `theta_s` is the saturation
+ * capacity, `b` is the Campbell `b` coefficient, and `K_s` is the saturated
+ * conductivity. The downward flux of water between neighboring layers `i` and
+ * `i + 1`, whose centers are separated by the layer thickness `dz`, is
+ *
+ * > `J_i = K_(i + 1/2) * ((psi_i - psi_(i + 1)) / dz + g)`
+ *
+ * where `K_(i + 1/2)` is the mean conductivity of the two layers and `g` is the
+ * acceleration due to gravity. Water drains freely from the bottom layer at a
+ * rate of `K * g`. Precipitation enters the top layer and soil evaporation is
+ * removed from it, while canopy transpiration is removed equally from all
+ * layers.
+ *
+ * ### Implicit update
+ *
+ * Because the conductivity changes by orders of magnitude as a layer wets up,
+ * these fluxes make the equations very stiff; after heavy rain, an explicit
+ * calculation like the one in `two_layer_soil_profile` forces adaptive ODE
+ * solvers to take many tiny steps. Instead, this module calculates the change
+ * in water content over one `timestep` using an implicit (backward) Euler
+ * step. The implicit equations are solved with a fixed number of Newton-like
+ * iterations: at each iteration, the conductivities and matric potentials are
+ * evaluated at the current estimate of the new water contents, the potentials
+ * are linearized about it, and the resulting tridiagonal system for the
+ * corrections is solved using the Thomas algorithm. The system is diagonally
+ * dominant by columns, so no pivoting is required. After each iteration, the
+ * water contents are limited to lie between the wilting point and the
+ * saturation capacity, and any water above saturation is lost as runoff. Using
+ * a fixed number of iterations rather than a convergence test ensures that the
+ * outputs are smooth functions of the inputs.
+ *
+ * The outputs are the changes in water content divided by `timestep`. These
+ * remain small and smooth even when the underlying fluxes are stiff, and they
+ * approach the derivatives of the water contents as `timestep` becomes small.
+ * The mean water content of the profile (`soil_water_content`) is updated in
+ * the same way, so modules that depend on it can be used alongside this one.
+ *
+ * Note that this module has a non-standard constructor, so it cannot be created
+ * using the module_factory. Rather, it is expected that directly-usable
+ * classes will be derived from this class.
+ */
+class multilayer_soil_water : public differential_module
+{
+   public:
+    multilayer_soil_water(
+        int const& nlayers,
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : differential_module{},
+
+          // Store the number of layers
+          nlayers(nlayers),
+
+          // Get references to input quantities
+          soil_water_content_layer_ips{get_multilayer_ip(input_quantities, nlayers, "soil_water_content")},
+          soil_water_content{get_input(input_quantities, "soil_water_content")},
+          soil_depth{get_input(input_quantities, "soil_depth")},
+          soil_saturation_capacity{get_input(input_quantities, "soil_saturation_capacity")},
+          soil_wilting_point{get_input(input_quantities, "soil_wilting_point")},
+          soil_saturated_conductivity{get_input(input_quantities, "soil_saturated_conductivity")},
+          soil_air_entry{get_input(input_quantities, "soil_air_entry")},
+          soil_b_coefficient{get_input(input_quantities, "soil_b_coefficient")},
+          acceleration_from_gravity{get_input(input_quantities, "acceleration_from_gravity")},
+          precipitation_rate{get_input(input_quantities, "precipitation_rate")},
+          canopy_transpiration_rate{get_input(input_quantities, "canopy_transpiration_rate")},
+          soil_evaporation_rate{get_input(input_quantities, "soil_evaporation_rate")},
+          timestep{get_input(input_quantities, "timestep")},
+
+          // Get pointers to output quantities
+          soil_water_content_layer_ops{get_multilayer_op(output_quantities, nlayers, "soil_water_content")},
+          soil_water_content_op{get_op(output_quantities, "soil_water_content")},
+
+          // Allocate storage for the tridiagonal system
+          theta(nlayers),
+          new_theta(nlayers),
+          potential(nlayers),
+          conductivity(nlayers),
+          dpsi_dtheta(nlayers),
+          sub_diagonal(nlayers),
+          diagonal(nlayers),
+          super_diagonal(nlayers),
+          rhs(nlayers)
+    {
+    }
+
+   private:
+    // Number of layers
+    int const nlayers;
+
+    // References to input quantities
+    std::vector<double const*> const soil_water_content_layer_ips;
+    double const& soil_water_content;
+    double const& soil_depth;
+    double const& soil_saturation_capacity;
+    double const& soil_wilting_point;
+    double const& soil_saturated_conductivity;
+    double const& soil_air_entry;
+    double const& soil_b_coefficient;
+    double const& acceleration_from_gravity;
+    double const& precipitation_rate;
+    double const& canopy_transpiration_rate;
+    double const& soil_evaporation_rate;
+    double const& timestep;
+
+    // Pointers to output quantities
+    std::vector<double*> const soil_water_content_layer_ops;
+    double* soil_water_content_op;
+
+    // Storage for the tridiagonal system, reused every time the module runs
+    std::vector<double> mutable theta;         // dimensionless
+    std::vector<double> mutable new_theta;     // dimensionless
+    std::vector<double> mutable potential;     // J / kg
+    std::vector<double> mutable conductivity;  // kg * s / m^3
+    std::vector<double> mutable dpsi_dtheta;   // J / kg
+    std::vector<double> mutable sub_diagonal;
+    std::vector<double> mutable diagonal;
+    std::vector<double> mutable super_diagonal;
+    std::vector<double> mutable rhs;
+
+   protected:
+    void run() const;
+    static string_vector get_inputs(int nlayers);
+    static string_vector get_outputs(int nlayers);
+};
+
+////////////////////////////////
+// N LAYER SOIL WATER MODULES //
+////////////////////////////////
+
+/**
+ * @class n_layer_soil_water
+ *
+ * @brief A child class of multilayer_soil_water where the number of layers has
+ * been fixed by the template parameter. Instances of this class can be created
+ * using the module factory, unlike the parent class `multilayer_soil_water`.
+ *
+ * The module name is formed from the number of layers (see
+ * `layer_count_name`); e.g., `n_layer_soil_water<10>` is the
+ * `ten_layer_soil_water` module.
+ */
+template <int number_of_layers>
+class n_layer_soil_water : public multilayer_soil_water
+{
+   public:
+    n_layer_soil_water(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : multilayer_soil_water(
+              number_of_layers,
+              input_quantities,
+              output_quantities)
+    {
+    }
+    static string_vector get_inputs()
+    {
+        return multilayer_soil_water::get_inputs(number_of_layers);
+    }
+    static string_vector get_outputs()
+    {
+        return multilayer_soil_water::get_outputs(number_of_layers);
+    }
+    static std::string get_name()
+    {
+        return layer_count_name<number_of_layers>::get() + "_layer_soil_water";
+    }
+
+   private:
+    // Main operation
+    void do_operation() const { multilayer_soil_water::run(); }
+};
+
+using three_layer_soil_water = n_layer_soil_water<3>;
+using five_layer_soil_water = n_layer_soil_water<5>;
+using ten_layer_soil_water = n_layer_soil_water<10>;
+using twenty_layer_soil_water = n_layer_soil_water<20>;
+
+}  // namespace standardBML
+#endif
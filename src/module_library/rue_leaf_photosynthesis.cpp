@@ -119,7 +119,83 @@ string_vector rue_leaf_photosynthesis::get_outputs()
     };
 }
 
+kernel_field_list<rue_leaf_photosynthesis::kernel_inputs> rue_leaf_photosynthesis::kernel_input_fields()
+{
+    return {
+        {"incident_ppfd", &kernel_inputs::incident_ppfd},
+        {"alpha_rue", &kernel_inputs::alpha_rue},
+        {"temp", &kernel_inputs::temp},
+        {"rh", &kernel_inputs::rh},
+        {"Rd", &kernel_inputs::Rd},
+        {"b0", &kernel_inputs::b0},
+        {"b1", &kernel_inputs::b1},
+        {"Catm", &kernel_inputs::Catm},
+        {"average_absorbed_shortwave", &kernel_inputs::average_absorbed_shortwave},
+        {"windspeed", &kernel_inputs::windspeed},
+        {"height", &kernel_inputs::height},
+        {"specific_heat_of_air", &kernel_inputs::specific_heat_of_air},
+        {"minimum_gbw", &kernel_inputs::minimum_gbw},
+        {"windspeed_height", &kernel_inputs::windspeed_height}
+    };
+}
+
+kernel_field_list<rue_leaf_photosynthesis::kernel_outputs> rue_leaf_photosynthesis::kernel_output_fields()
+{
+    return {
+        {"Assim", &kernel_outputs::Assim},
+        {"GrossAssim", &kernel_outputs::GrossAssim},
+        {"Rp", &kernel_outputs::Rp},
+        {"Ci", &kernel_outputs::Ci},
+        {"Gs", &kernel_outputs::Gs},
+        {"TransR", &kernel_outputs::TransR},
+        {"EPenman", &kernel_outputs::EPenman},
+        {"EPriestly", &kernel_outputs::EPriestly},
+        {"leaf_temperature", &kernel_outputs::leaf_temperature},
+        {"gbw", &kernel_outputs::gbw}
+    };
+}
+
 void rue_leaf_photosynthesis::do_operation() const
+{
+    kernel_inputs const in{
+        .incident_ppfd = incident_ppfd,
+        .alpha_rue = alpha_rue,
+        .temp = temp,
+        .rh = rh,
+        .Rd = Rd,
+        .b0 = b0,
+        .b1 = b1,
+        .Catm = Catm,
+        .average_absorbed_shortwave = average_absorbed_shortwave,
+        .windspeed = windspeed,
+        .height = height,
+        .specific_heat_of_air = specific_heat_of_air,
+        .minimum_gbw = minimum_gbw,
+        .windspeed_height = windspeed_height
+    };
+
+    kernel_outputs const out = kernel(in);
+
+    // Update the outputs
+    update(Assim_op, out.Assim);
+    update(GrossAssim_op, out.GrossAssim);
+    update(Rp_op, out.Rp);
+    update(Ci_op, out.Ci);
+    update(Gs_op, out.Gs);
+    update(TransR_op, out.TransR);
+    update(EPenman_op, out.EPenman);
+    update(EPriestly_op, out.EPriestly);
+    update(leaf_temperature_op, out.leaf_temperature);
+    update(gbw_op, out.gbw);
+}
+
+/**
+ * @brief Performs the calculations for this module without requiring a module
+ * object, using the input values in `in` and returning the output values.
+ *
+ * See `c3_leaf_photosynthesis::kernel()` for more details.
+ */
+rue_leaf_photosynthesis::kernel_outputs rue_leaf_photosynthesis::kernel(kernel_inputs const& in)
 {
     // Make an initial guess for boundary layer conductance
     double const gbw_guess{1.2};  // mol / m^2 / s
@@ -128,56 +204,57 @@ void rue_leaf_photosynthesis::do_operation() const
     // air temperature
     const double initial_stomatal_conductance =
         rue_photo(
-            incident_ppfd * 1e-6,  // mol / m^2 / s
-            alpha_rue,             // dimensionless
-            temp,                  // degrees C
-            rh,                    // dimensionless from Pa / Pa
-            Rd * 1e-6,             // mol / m^2 / s
-            b0,                    // mol / m^2 / s
-            b1,                    // dimensionless
-            Catm * 1e-6,           // dimensionless from mol / mol
-            gbw_guess              // mol / m^2 / s
+            in.incident_ppfd * 1e-6,  // mol / m^2 / s
+            in.alpha_rue,             // dimensionless
+            in.temp,                  // degrees C
+            in.rh,                    // dimensionless from Pa / Pa
+            in.Rd * 1e-6,             // mol / m^2 / s
+            in.b0,                    // mol / m^2 / s
+            in.b1,                    // dimensionless
+            in.Catm * 1e-6,           // dimensionless from mol / mol
+            gbw_guess                 // mol / m^2 / s
             )
             .Gs;  // mmol / m^2 / s
 
     // Calculate a new value for leaf temperature
     const struct ET_Str et = c3EvapoTrans(
-        average_absorbed_shortwave,
-        temp,
-        rh,
-        windspeed,
-        height,
-        specific_heat_of_air,
+        in.average_absorbed_shortwave,
+        in.temp,
+        in.rh,
+        in.windspeed,
+        in.height,
+        in.specific_heat_of_air,
         initial_stomatal_conductance,
-        minimum_gbw,
-        windspeed_height);
+        in.minimum_gbw,
+        in.windspeed_height);
 
-    const double leaf_temperature = temp + et.Deltat;  // deg. C
+    const double leaf_temperature = in.temp + et.Deltat;  // deg. C
 
     // Calculate final values for assimilation, stomatal conductance, and Ci
     // using the new leaf temperature
     const photosynthesis_outputs photo =
         rue_photo(
-            incident_ppfd * 1e-6,          // mol / m^2 / s
-            alpha_rue,                     // dimensionless
+            in.incident_ppfd * 1e-6,       // mol / m^2 / s
+            in.alpha_rue,                  // dimensionless
             leaf_temperature,              // degrees C
-            rh,                            // dimensionless from Pa / Pa
-            Rd * 1e-6,                     // mol / m^2 / s
-            b0,                            // mol / m^2 / s
-            b1,                            // dimensionless
-            Catm * 1e-6,                   // dimensionless from mol / mol
+            in.rh,                         // dimensionless from Pa / Pa
+            in.Rd * 1e-6,                  // mol / m^2 / s
+            in.b0,                         // mol / m^2 / s
+            in.b1,                         // dimensionless
+            in.Catm * 1e-6,                // dimensionless from mol / mol
             et.boundary_layer_conductance  // mol / m^2 / s
         );
 
-    // Update the outputs
-    update(Assim_op, photo.Assim);
-    update(GrossAssim_op, photo.GrossAssim);
-    update(Rp_op, photo.Rp);
-    update(Ci_op, photo.Ci);
-    update(Gs_op, photo.Gs);
-    update(TransR_op, et.TransR);
-    update(EPenman_op, et.EPenman);
-    update(EPriestly_op, et.EPriestly);
-    update(leaf_temperature_op, leaf_temperature);
-    update(gbw_op, et.boundary_layer_conductance);
+    return kernel_outputs{
+        .Assim = photo.Assim,
+        .GrossAssim = photo.GrossAssim,
+        .Rp = photo.Rp,
+        .Ci = photo.Ci,
+        .Gs = photo.Gs,
+        .TransR = et.TransR,
+        .EPenman = et.EPenman,
+        .EPriestly = et.EPriestly,
+        .leaf_temperature = leaf_temperature,
+        .gbw = et.boundary_layer_conductance
+    };
 }
@@ -3,6 +3,7 @@
 
 #include "../framework/module.h"
 #include "../framework/state_map.h"
+#include "kernel_fields.h"  // for kernel_field_list
 
 namespace standardBML
 {
@@ -166,6 +167,42 @@ class rue_leaf_photosynthesis : public direct_module
     static string_vector get_outputs();
     static std::string get_name() { return "rue_leaf_photosynthesis"; }
 
+    // Values of the input and output quantities used by `kernel()`, named as
+    // in `get_inputs()` and `get_outputs()`
+    struct kernel_inputs {
+        double incident_ppfd;               // micromol / (m^2 leaf) / s
+        double alpha_rue;                   // dimensionless
+        double temp;                        // deg. C
+        double rh;                          // dimensionless
+        double Rd;                          // micromol / m^2 / s
+        double b0;                          // mol / m^2 / s
+        double b1;                          // dimensionless
+        double Catm;                        // micromol / mol
+        double average_absorbed_shortwave;  // J / (m^2 leaf) / s
+        double windspeed;                   // m / s
+        double height;                      // m
+        double specific_heat_of_air;        // J / kg / K
+        double minimum_gbw;                 // mol / m^2 / s
+        double windspeed_height;            // m
+    };
+
+    struct kernel_outputs {
+        double Assim;             // micromol / m^2 /s
+        double GrossAssim;        // micromol / m^2 /s
+        double Rp;                // micromol / m^2 / s
+        double Ci;                // micromol / mol
+        double Gs;                // mmol / m^2 / s
+        double TransR;            // mmol / m^2 / s
+        double EPenman;           // mmol / m^2 / s
+        double EPriestly;         // mmol / m^2 / s
+        double leaf_temperature;  // deg. C
+        double gbw;               // mol / m^2 / s
+    };
+
+    static kernel_field_list<kernel_inputs> kernel_input_fields();
+    static kernel_field_list<kernel_outputs> kernel_output_fields();
+    static kernel_outputs kernel(kernel_inputs const& in);
+
    private:
     // References to input parameters
     double const& incident_ppfd;
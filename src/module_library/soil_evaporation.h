@@ -12,7 +12,8 @@ class soil_evaporation : public direct_module
    public:
     soil_evaporation(
         state_map const& input_quantities,
-        state_map* output_quantities)
+        state_map* output_quantities,
+        saturation_vapor_pressure_function swvp = saturation_vapor_pressure)
         : direct_module{},
 
           // Get references to input quantities
@@ -32,7 +33,9 @@ class soil_evaporation : public direct_module
           par_energy_content{get_input(input_quantities, "par_energy_content")},
 
           // Get pointers to output quantities
-          soil_evaporation_rate_op{get_op(output_quantities, "soil_evaporation_rate")}
+          soil_evaporation_rate_op{get_op(output_quantities, "soil_evaporation_rate")},
+
+          swvp{swvp}
     {
     }
     static string_vector get_inputs();
@@ -59,6 +62,9 @@ class soil_evaporation : public direct_module
     // Pointers to output quantities
     double* soil_evaporation_rate_op;
 
+    // Function used to calculate saturation water vapor pressure
+    saturation_vapor_pressure_function const swvp;
+
     // Main operation
     void do_operation() const;
 };
@@ -98,7 +104,7 @@ void soil_evaporation::do_operation() const
         lai, 0.68, temp, solar, soil_water_content, soil_field_capacity,
         soil_wilting_point, windspeed, rh, rsec, soil_clod_size,
         soil_reflectance, soil_transmission, specific_heat_of_air,
-        par_energy_content);  // kg / m^2 / s
+        par_energy_content, swvp);  // kg / m^2 / s
 
     // Convert units for consistency with canopy_transpiration_rate and
     // two_layer_soil_profile's output
@@ -108,5 +114,27 @@ void soil_evaporation::do_operation() const
     update(soil_evaporation_rate_op, soilEvap);
 }
 
+/**
+ * @class soil_evaporation_tabulated_swvp
+ *
+ * @brief Identical to `soil_evaporation`, except that saturation water vapor
+ * pressure is calculated by `saturation_vapor_pressure_tabulated()` rather
+ * than `saturation_vapor_pressure()`.
+ */
+class soil_evaporation_tabulated_swvp : public soil_evaporation
+{
+   public:
+    soil_evaporation_tabulated_swvp(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : soil_evaporation{
+              input_quantities,
+              output_quantities,
+              saturation_vapor_pressure_tabulated}
+    {
+    }
+    static std::string get_name() { return "soil_evaporation_tabulated_swvp"; }
+};
+
 }  // namespace standardBML
 #endif
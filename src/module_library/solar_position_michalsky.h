@@ -1,10 +1,9 @@
 #ifndef SOLAR_POSITION_MICHALSKY_H
 #define SOLAR_POSITION_MICHALSKY_H
 
-#include <cmath>                               // for floor, fmod
-#include "../framework/degree_trigonometry.h"  // for atan2_deg, cos_deg, sin_deg, acos_deg
 #include "../framework/module.h"
 #include "../framework/state_map.h"
+#include "michalsky_solar_coordinates.h"  // for michalsky_time_conversion, michalsky_celestial, michalsky_local
 
 namespace standardBML
 {
@@ -187,77 +186,24 @@ string_vector solar_position_michalsky::get_outputs()
 
 void solar_position_michalsky::do_operation() const
 {
-    // Define some constants
-    double constexpr deg_to_hr = 1.0 / 15.0;
-    double constexpr hr_to_deg = 15.0;
-    double constexpr hr_per_day = 24.0;
-    double constexpr deg_per_rev = 360.0;
-
-    double constexpr jd_ref_1948 = 2432916.5;  // Julian date at midnight on 31 December 1948 (UTC)
-    double constexpr jd_ref_2000 = 2451545.0;  // Julian date at noon on 1 January 2000 (UTC)
-
-    // Unpack the doy and hour in UTC
-    double time_utc = time - time_zone_offset / hr_per_day;     // days
-    double const doy_utc = floor(time_utc);                     // days
-    double const hour_utc = hr_per_day * (time_utc - doy_utc);  // hours
-
-    // Calculate the Julian date
-    double const delta = year - 1949.0;
-    double const leap = floor(0.25 * delta);
-    double const jd = jd_ref_1948 + delta * 365.0 + leap + doy_utc + hour_utc / hr_per_day;  // days
-
-    // Calculate the "n" date
-    double const n = jd - jd_ref_2000;  // days
-
-    // Calculate the ecliptic coordinates of the sun
-    double const L = fmod(280.460 + 0.9856474 * n, deg_per_rev);                            // degrees
-    double const g = fmod(357.528 + 0.9856003 * n, deg_per_rev);                            // degrees
-    double const ell = fmod(L + 1.915 * sin_deg(g) + 0.020 * sin_deg(2 * g), deg_per_rev);  // degrees
-    double const ep = 23.439 - 0.0000004 * n;                                               // degrees
-
-    // Calculate the equatorial celestial coordinates of the sun
-    double const ra = atan2_deg(cos_deg(ep) * sin_deg(ell), cos_deg(ell));  // degrees
-    double const dec = asin_deg(sin_deg(ep) * sin_deg(ell));                // degrees
-
-    // Calculate the sidereal time
-    double const gmst = fmod(6.697375 + 0.0657098242 * n + hour_utc, hr_per_day);  // hours
-    double const lmst = fmod(gmst + longitude * deg_to_hr, hr_per_day);            // hours
-
-    // Convert to local coordinates
-    double const lha = fmod(lmst * hr_to_deg - ra, deg_per_rev);  // degrees
-
-    double const zen = acos_deg(sin_deg(dec) * sin_deg(lat) +
-                                cos_deg(dec) * cos_deg(lat) * cos_deg(lha));  // degrees
-
-    double az = asin_deg(-cos_deg(dec) * sin_deg(lha) / cos_deg(90.0 - zen));  // degrees
-
-    // Make sure azimuth is in the correct quadrant
-    double const el = 90.0 - zen;                                      // degrees
-    double const el_critical = asin_deg(sin_deg(dec) / sin_deg(lat));  // degrees
-
-    if (el >= el_critical) {
-        az = 180.0 - az;  // degrees
-    } else if (lha > 0) {
-        az = 360.0 + az;  // degrees
-    }
-
-    // Determine the cosine of the zenith angle
-    double const cos_zen = cos_deg(zen);  // dimensionless
+    michalsky_time const t = michalsky_time_conversion(time, time_zone_offset, year);
+    michalsky_celestial_coordinates const c = michalsky_celestial(t.n);
+    michalsky_local_coordinates const l = michalsky_local(t, c, lat, longitude);
 
     // Update the output pointers
-    update(cosine_zenith_angle_op, cos_zen);
-    update(julian_date_op, jd);
-    update(solar_L_op, L);
-    update(solar_g_op, g);
-    update(solar_ell_op, ell);
-    update(solar_ep_op, ep);
-    update(solar_ra_op, ra);
-    update(solar_dec_op, dec);
-    update(gmst_op, gmst);
-    update(lmst_op, lmst);
-    update(lha_op, lha);
-    update(solar_zenith_angle_op, zen);
-    update(solar_azimuth_angle_op, az);
+    update(cosine_zenith_angle_op, l.cos_zen);
+    update(julian_date_op, t.jd);
+    update(solar_L_op, c.L);
+    update(solar_g_op, c.g);
+    update(solar_ell_op, c.ell);
+    update(solar_ep_op, c.ep);
+    update(solar_ra_op, c.ra);
+    update(solar_dec_op, c.dec);
+    update(gmst_op, l.gmst);
+    update(lmst_op, l.lmst);
+    update(lha_op, l.lha);
+    update(solar_zenith_angle_op, l.zen);
+    update(solar_azimuth_angle_op, l.az);
 }
 
 }  // namespace standardBML
@@ -0,0 +1,175 @@
+#ifndef SOLAR_POSITION_MICHALSKY_TABULATED_H
+#define SOLAR_POSITION_MICHALSKY_TABULATED_H
+
+#include <cmath>   // for std::floor
+#include <memory>  // for std::shared_ptr
+#include "../framework/module.h"
+#include "../framework/state_map.h"
+#include "michalsky_solar_coordinates.h"  // for michalsky_celestial_table, michalsky_local
+
+namespace standardBML
+{
+/**
+ *  @class solar_position_michalsky_tabulated
+ *
+ *  @brief Calculates the solar position using the same model as the
+ *  `solar_position_michalsky` module, but interpolates the sun's celestial
+ *  coordinates from a precomputed table rather than calculating them directly.
+ *
+ *  The celestial coordinates (the ecliptic longitude, right ascension, and
+ *  declination) do not depend on the location, and they change slowly over
+ *  the course of a year. Calculating them requires most of the trigonometric
+ *  functions used by `solar_position_michalsky`, so this module looks them up
+ *  in a `michalsky_celestial_table` that stores them at hourly intervals. The
+ *  table for each year is built the first time it is needed and is then shared
+ *  by every simulation that uses this module, including simulations that are
+ *  running at the same time. The sidereal times and the coordinates of the sun
+ *  in the local sky are calculated exactly from the interpolated values, as in
+ *  `solar_position_michalsky`.
+ *
+ *  If the year changes during a simulation, the table for the new year is
+ *  used. If the year is not a whole number between 1 and 9999, or the time is
+ *  outside the range covered by the table, the celestial coordinates are
+ *  calculated directly instead.
+ *
+ *  The angles calculated by this module differ from those calculated by
+ *  `solar_position_michalsky` by less than 1e-5 degrees, and
+ *  `cosine_zenith_angle` differs by less than 1e-7, which is much smaller than
+ *  the uncertainty of the model. The exception is the azimuth when the sun is
+ *  nearly overhead, where it is very sensitive to the declination and can
+ *  differ by a few thousandths of a degree. When exact agreement with the
+ *  `solar_position_michalsky` module is required, that module should be used
+ *  instead.
+ */
+class solar_position_michalsky_tabulated : public direct_module
+{
+   public:
+    solar_position_michalsky_tabulated(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : direct_module{},
+
+          // Get references to input quantities
+          lat{get_input(input_quantities, "lat")},
+          longitude{get_input(input_quantities, "longitude")},
+          time{get_input(input_quantities, "time")},
+          time_zone_offset{get_input(input_quantities, "time_zone_offset")},
+          year{get_input(input_quantities, "year")},
+
+          // Get pointers to output quantities
+          cosine_zenith_angle_op{get_op(output_quantities, "cosine_zenith_angle")},
+          julian_date_op{get_op(output_quantities, "julian_date")},
+          solar_L_op{get_op(output_quantities, "solar_L")},
+          solar_g_op{get_op(output_quantities, "solar_g")},
+          solar_ell_op{get_op(output_quantities, "solar_ell")},
+          solar_ep_op{get_op(output_quantities, "solar_ep")},
+          solar_ra_op{get_op(output_quantities, "solar_ra")},
+          solar_dec_op{get_op(output_quantities, "solar_dec")},
+          gmst_op{get_op(output_quantities, "gmst")},
+          lmst_op{get_op(output_quantities, "lmst")},
+          lha_op{get_op(output_quantities, "lha")},
+          solar_zenith_angle_op{get_op(output_quantities, "solar_zenith_angle")},
+          solar_azimuth_angle_op{get_op(output_quantities, "solar_azimuth_angle")}
+    {
+    }
+    static string_vector get_inputs();
+    static string_vector get_outputs();
+    static std::string get_name() { return "solar_position_michalsky_tabulated"; }
+
+   private:
+    // References to input quantities
+    double const& lat;
+    double const& longitude;
+    double const& time;
+    double const& time_zone_offset;
+    double const& year;
+
+    // Pointers to output quantities
+    double* cosine_zenith_angle_op;
+    double* julian_date_op;
+    double* solar_L_op;
+    double* solar_g_op;
+    double* solar_ell_op;
+    double* solar_ep_op;
+    double* solar_ra_op;
+    double* solar_dec_op;
+    double* gmst_op;
+    double* lmst_op;
+    double* lha_op;
+    double* solar_zenith_angle_op;
+    double* solar_azimuth_angle_op;
+
+    // The table for the most recent year
+    std::shared_ptr<michalsky_celestial_table const> mutable table;
+
+    // Main operation
+    void do_operation() const;
+};
+
+string_vector solar_position_michalsky_tabulated::get_inputs()
+{
+    return {
+        "lat",               // degrees (North is positive)
+        "longitude",         // degrees (East is positive)
+        "time",              // time expressed as a fractional day of year
+        "time_zone_offset",  // the offset of the time zone relative to UTC
+        "year"               // a year between 1950 and 2050
+    };
+}
+
+string_vector solar_position_michalsky_tabulated::get_outputs()
+{
+    return {
+        "cosine_zenith_angle",  // dimensionless
+        "julian_date",          // days
+        "solar_L",              // degrees
+        "solar_g",              // degrees
+        "solar_ell",            // degrees
+        "solar_ep",             // degrees
+        "solar_ra",             // degrees
+        "solar_dec",            // degrees
+        "gmst",                 // hours
+        "lmst",                 // hours
+        "lha",                  // degrees
+        "solar_zenith_angle",   // degrees
+        "solar_azimuth_angle"   // degrees
+    };
+}
+
+void solar_position_michalsky_tabulated::do_operation() const
+{
+    michalsky_time const t = michalsky_time_conversion(time, time_zone_offset, year);
+
+    // Tables are only built for whole-number years; this check is also false
+    // for NaN
+    bool const use_table = year >= 1 && year <= 9999 && year == std::floor(year);
+
+    if (use_table && (!table || table->get_year() != year)) {
+        table = michalsky_celestial_table::get(static_cast<int>(year));
+    }
+
+    michalsky_celestial_coordinates const c =
+        use_table && table->covers(t.time_utc)
+            ? table->interpolate(t)
+            : michalsky_celestial(t.n);
+
+    michalsky_local_coordinates const l = michalsky_local(t, c, lat, longitude);
+
+    // Update the output pointers
+    update(cosine_zenith_angle_op, l.cos_zen);
+    update(julian_date_op, t.jd);
+    update(solar_L_op, c.L);
+    update(solar_g_op, c.g);
+    update(solar_ell_op, c.ell);
+    update(solar_ep_op, c.ep);
+    update(solar_ra_op, c.ra);
+    update(solar_dec_op, c.dec);
+    update(gmst_op, l.gmst);
+    update(lmst_op, l.lmst);
+    update(lha_op, l.lha);
+    update(solar_zenith_angle_op, l.zen);
+    update(solar_azimuth_angle_op, l.az);
+}
+
+}  // namespace standardBML
+#endif
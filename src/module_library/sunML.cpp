@@ -1,5 +1,20 @@
+#include <cmath>      // for exp, sqrt, pow, acos, tan
+#include <stdexcept>  // for std::out_of_range
 #include "sunML.h"
 
+void Light_profile::resize(int nlayers)
+{
+    for (std::vector<double>* v : {
+             &sunlit_incident_ppfd, &incident_ppfd_scattered,
+             &shaded_incident_ppfd, &average_incident_ppfd,
+             &sunlit_absorbed_ppfd, &shaded_absorbed_ppfd,
+             &sunlit_absorbed_shortwave, &shaded_absorbed_shortwave,
+             &average_absorbed_shortwave, &sunlit_fraction, &shaded_fraction,
+             &height}) {
+        v->resize(nlayers);
+    }
+}
+
 /**
  *  @brief Computes absorbed light from incident light for a thin layer of
  *  material.
@@ -145,6 +160,16 @@ double absorbed_shortwave_from_incident_ppfd(
  *  @brief Computes an n-layered light profile from the direct light, diffuse
  *  light, leaf area index, solar zenith angle, and other parameters.
  *
+ *  The profile is written to `light_profile`, whose arrays are resized to
+ *  `nlayers` if necessary; callers that compute many profiles can therefore
+ *  reuse the same `Light_profile` object to avoid reallocating its arrays.
+ *
+ *  Since the layers all have the same leaf area, the exponential attenuation
+ *  factors form geometric sequences from the top of the canopy to the bottom,
+ *  so they are calculated by repeated multiplication rather than by calling
+ *  `exp()` in every layer. Likewise, the absorbed light is proportional to the
+ *  incident light, so the absorbed fractions are only calculated once.
+ *
  *  @param [in] ambient_ppfd_beam Photosynthetically active photon flux density
  *              (PPFD) for beam light passing through a surface perpendicular
  *              to the beam direction at the top of the canopy; this represents
@@ -181,11 +206,12 @@ double absorbed_shortwave_from_incident_ppfd(
  *  @param [in] heightf Leaf area density, i.e., LAI per height of canopy (m^-1
  *              from m^2 leaf / m^2 ground / m height)
  *
- *  @return An n-layered light profile representing quantities within
- *          the canopy, including several photon flux densities and
- *          the relative fractions of shaded and sunlit leaves
+ *  @param [out] light_profile An n-layered light profile representing
+ *               quantities within the canopy, including several photon flux
+ *               densities and the relative fractions of shaded and sunlit
+ *               leaves
  */
-Light_profile sunML(
+void sunML(
     double ambient_ppfd_beam,     // micromol / (m^2 beam) / s
     double ambient_ppfd_diffuse,  // micromol / m^2 / s
     double lai,                   // dimensionless from m^2 / m^2
@@ -198,11 +224,12 @@ Light_profile sunML(
     double par_energy_content,    // J / micromol
     double par_energy_fraction,   // dimensionless
     double leaf_transmittance,    // dimensionless
-    double leaf_reflectance       // dimensionless
+    double leaf_reflectance,      // dimensionless
+    Light_profile& light_profile  // outputs
 )
 {
-    if (nlayers < 1 || nlayers > MAXLAY) {
-        throw std::out_of_range("nlayers must be at least 1 but no more than MAXLAY.");
+    if (nlayers < 1) {
+        throw std::out_of_range("nlayers must be at least 1.");
     }
     if (cosine_zenith_angle > 1 || cosine_zenith_angle < -1) {
         throw std::out_of_range("cosine_zenith_angle must be between -1 and 1.");
@@ -249,8 +276,50 @@ Light_profile sunML(
     // Calculate the ambient direct PPFD through a unit area of leaf surface
     double ambient_ppfd_beam_leaf = ambient_ppfd_beam_ground * k;  // micromol / (m^2 leaf) / s
 
-    // Start to fill in the light profile values
-    Light_profile light_profile;
+    // For values of cosine_zenith_angle close to or less than 0, in place of
+    // the calculations below, we want to use the limits of those expressions as
+    // cosine_zenith_angle approaches 0 from the right
+    const bool sun_below_horizon = cosine_zenith_angle <= 1E-10;
+
+    if (sun_below_horizon) {
+        ambient_ppfd_beam_leaf = ambient_ppfd_beam / k1;
+    }
+
+    // The cumulative LAI above the center of the `i`th layer is
+    // `lai_per_layer * (i + 0.5)`, so each exponential of the form
+    // `exp(-c * cumulative_lai)` is the product of its value in the top layer
+    // and `exp(-c * lai_per_layer)` raised to the `i`th power
+    const double kb_scattered = k * sqrt(absorptivity);  // dimensionless
+
+    const double step_direct = exp(-k * lai_per_layer);               // dimensionless
+    const double step_scattered = exp(-kb_scattered * lai_per_layer);  // dimensionless
+    const double step_diffuse = exp(-kd * lai_per_layer);              // dimensionless
+
+    double attenuation_direct = exp(-k * lai_per_layer * 0.5);               // dimensionless
+    double attenuation_scattered = exp(-kb_scattered * lai_per_layer * 0.5);  // dimensionless
+    double attenuation_diffuse = exp(-kd * lai_per_layer * 0.5);              // dimensionless
+
+    // The fraction of light intercepted by the leaves in one layer, which is
+    // used to calculate the sunlit fraction and the average PPFD
+    const double layer_interception = (1 - step_direct) / k;  // dimensionless
+
+    // The absorbed light is proportional to the incident light, so we only
+    // need to calculate the proportionality constants once
+    const double ppfd_absorption_fraction =
+        thin_layer_absorption(
+            leaf_reflectance,
+            leaf_transmittance,
+            1.0);  // dimensionless
+
+    const double shortwave_per_ppfd =
+        absorbed_shortwave_from_incident_ppfd(
+            1.0,
+            par_energy_content,
+            par_energy_fraction,
+            leaf_reflectance,
+            leaf_transmittance);  // J / micromol
+
+    light_profile.resize(nlayers);
     light_profile.canopy_direct_transmission_fraction = canopy_direct_transmission_fraction;
 
     // Fill in the layer-dependent light profile values
@@ -264,87 +333,59 @@ Light_profile sunML(
         // example 15.2. This is a diffuse flux density representing the flux
         // through any surface.
         const double scattered_ppfd =
-            ambient_ppfd_beam_ground * (exp(-k * sqrt(absorptivity) * cumulative_lai) -
-                                        exp(-k * cumulative_lai));  // micromol / m^2 / s
+            ambient_ppfd_beam_ground * (attenuation_scattered - attenuation_direct);  // micromol / m^2 / s
 
         // Calculate the total flux of diffuse photosynthetically active light
         // in this layer by combining the scattered PPFD with the ambient
         // diffuse PPFD. Here we use Equation 15.6 with `alpha` = 1 and
         // `kbe(phi)` = kd.
-        double diffuse_ppfd =
-            ambient_ppfd_diffuse * exp(-kd * cumulative_lai) + scattered_ppfd;  // micromol / m^2 / s
-
-        // Calculate the fraction of sunlit and shaded leaves in this canopy
-        // layer using Equation 15.21.
-        const double Ls = (1 - exp(-k * lai_per_layer)) * exp(-k * cumulative_lai) / k;  // dimensionless
-        double sunlit_fraction = Ls / lai_per_layer;                                     // dimensionless
-        double shaded_fraction = 1 - sunlit_fraction;                                    // dimensionless
-
-        // Calculate an "average" incident PPFD for the sunlit and shaded leaves
-        // that doesn't seem to be based on a formula from Campbell & Norman
-        // (1998). It's interpreted as a flux density through a unit of leaf
-        // area, but that may not be correct.
-        double average_ppfd =
-            (sunlit_fraction * (ambient_ppfd_beam_leaf + diffuse_ppfd) + shaded_fraction * diffuse_ppfd) *
-            (1 - exp(-k * lai_per_layer)) / k;  // micromol / (m^2 leaf) / s
-
-        // For values of cosine_zenith_angle close to or less than 0, in place
-        // of the calculations above, we want to use the limits of the above
-        // expressions as cosine_zenith_angle approaches 0 from the right:
-        if (cosine_zenith_angle <= 1E-10) {
-            ambient_ppfd_beam_leaf = ambient_ppfd_beam / k1;
-            diffuse_ppfd = ambient_ppfd_diffuse * exp(-kd * cumulative_lai);
-            sunlit_fraction = 0;
-            shaded_fraction = 1;
-            average_ppfd = 0;
+        double diffuse_ppfd = ambient_ppfd_diffuse * attenuation_diffuse;  // micromol / m^2 / s
+
+        double sunlit_fraction = 0;  // dimensionless from m^2 / m^2
+        double shaded_fraction = 1;  // dimensionless from m^2 / m^2
+        double average_ppfd = 0;     // micromol / (m^2 leaf) / s
+
+        if (!sun_below_horizon) {
+            diffuse_ppfd += scattered_ppfd;
+
+            // Calculate the fraction of sunlit and shaded leaves in this canopy
+            // layer using Equation 15.21.
+            const double Ls = layer_interception * attenuation_direct;  // dimensionless
+            sunlit_fraction = Ls / lai_per_layer;                       // dimensionless
+            shaded_fraction = 1 - sunlit_fraction;                      // dimensionless
+
+            // Calculate an "average" incident PPFD for the sunlit and shaded
+            // leaves that doesn't seem to be based on a formula from Campbell &
+            // Norman (1998). It's interpreted as a flux density through a unit
+            // of leaf area, but that may not be correct.
+            average_ppfd =
+                (sunlit_fraction * (ambient_ppfd_beam_leaf + diffuse_ppfd) + shaded_fraction * diffuse_ppfd) *
+                layer_interception;  // micromol / (m^2 leaf) / s
         }
 
+        const double sunlit_ppfd = ambient_ppfd_beam_leaf + diffuse_ppfd;  // micromol / (m^2 leaf) / s
+
         // Store values of incident PPFD
-        light_profile.sunlit_incident_ppfd[i] = ambient_ppfd_beam_leaf + diffuse_ppfd;  // micromol / (m^2 leaf) / s
-        light_profile.incident_ppfd_scattered[i] = scattered_ppfd;                      // micromol / m^2 / s
-        light_profile.shaded_incident_ppfd[i] = diffuse_ppfd;                           // micromol / (m^2 leaf) / s
-        light_profile.average_incident_ppfd[i] = average_ppfd;                          // micromol / (m^2 leaf) / s
-        light_profile.sunlit_fraction[i] = sunlit_fraction;                             // dimensionless from m^2 / m^2
-        light_profile.shaded_fraction[i] = shaded_fraction;                             // dimensionless from m^2 / m^2
-        light_profile.height[i] = (lai - cumulative_lai) / heightf;                     // m
+        light_profile.sunlit_incident_ppfd[i] = sunlit_ppfd;             // micromol / (m^2 leaf) / s
+        light_profile.incident_ppfd_scattered[i] = scattered_ppfd;       // micromol / m^2 / s
+        light_profile.shaded_incident_ppfd[i] = diffuse_ppfd;            // micromol / (m^2 leaf) / s
+        light_profile.average_incident_ppfd[i] = average_ppfd;           // micromol / (m^2 leaf) / s
+        light_profile.sunlit_fraction[i] = sunlit_fraction;              // dimensionless from m^2 / m^2
+        light_profile.shaded_fraction[i] = shaded_fraction;              // dimensionless from m^2 / m^2
+        light_profile.height[i] = (lai - cumulative_lai) / heightf;      // m
 
         // Store values of absorbed PPFD
-        light_profile.sunlit_absorbed_ppfd[i] =
-            thin_layer_absorption(
-                leaf_reflectance,
-                leaf_transmittance,
-                ambient_ppfd_beam_leaf + diffuse_ppfd);  // micromol / m^2 / s
-
-        light_profile.shaded_absorbed_ppfd[i] =
-            thin_layer_absorption(
-                leaf_reflectance,
-                leaf_transmittance,
-                diffuse_ppfd);  // micromol / m^2 / s
+        light_profile.sunlit_absorbed_ppfd[i] = sunlit_ppfd * ppfd_absorption_fraction;   // micromol / m^2 / s
+        light_profile.shaded_absorbed_ppfd[i] = diffuse_ppfd * ppfd_absorption_fraction;  // micromol / m^2 / s
 
         // Store values of absorbed solar energy (including PAR and NIR)
-        light_profile.sunlit_absorbed_shortwave[i] =
-            absorbed_shortwave_from_incident_ppfd(
-                ambient_ppfd_beam_leaf + diffuse_ppfd,
-                par_energy_content,
-                par_energy_fraction,
-                leaf_reflectance,
-                leaf_transmittance);  // J / (m^2 leaf) / s
-
-        light_profile.shaded_absorbed_shortwave[i] =
-            absorbed_shortwave_from_incident_ppfd(
-                diffuse_ppfd,
-                par_energy_content,
-                par_energy_fraction,
-                leaf_reflectance,
-                leaf_transmittance);  // J / (m^2 leaf) / s
-
-        light_profile.average_absorbed_shortwave[i] =
-            absorbed_shortwave_from_incident_ppfd(
-                average_ppfd,
-                par_energy_content,
-                par_energy_fraction,
-                leaf_reflectance,
-                leaf_transmittance);  // J / (m^2 leaf) / s
+        light_profile.sunlit_absorbed_shortwave[i] = sunlit_ppfd * shortwave_per_ppfd;    // J / (m^2 leaf) / s
+        light_profile.shaded_absorbed_shortwave[i] = diffuse_ppfd * shortwave_per_ppfd;   // J / (m^2 leaf) / s
+        light_profile.average_absorbed_shortwave[i] = average_ppfd * shortwave_per_ppfd;  // J / (m^2 leaf) / s
+
+        // Move to the next layer down
+        attenuation_direct *= step_direct;
+        attenuation_scattered *= step_scattered;
+        attenuation_diffuse *= step_diffuse;
     }
-    return light_profile;
 }
@@ -1,22 +1,30 @@
 #ifndef SUNML_H
 #define SUNML_H
 
-#include "AuxBioCro.h"  // for MAXLAY
+#include <vector>
 
+// A light profile stored as one array per quantity, each having one element per
+// canopy layer. It is filled in place by `sunML`, so the same profile can be
+// reused for many calls without reallocating its arrays.
 struct Light_profile {
-    double sunlit_incident_ppfd[MAXLAY];        // micromol / (m^2 leaf) / s
-    double incident_ppfd_scattered[MAXLAY];     // micromol / m^2 / s
-    double shaded_incident_ppfd[MAXLAY];        // micromol / (m^2 leaf) / s
-    double average_incident_ppfd[MAXLAY];       // micromol / (m^2 leaf) / s
-    double sunlit_absorbed_ppfd[MAXLAY];        // micromol / (m^2 leaf) / s
-    double shaded_absorbed_ppfd[MAXLAY];        // micromol / (m^2 leaf) / s
-    double sunlit_absorbed_shortwave[MAXLAY];   // J / (m^2 leaf) / s
-    double shaded_absorbed_shortwave[MAXLAY];   // J / (m^2 leaf) / s
-    double average_absorbed_shortwave[MAXLAY];  // J / (m^2 leaf) / s
-    double sunlit_fraction[MAXLAY];             // dimensionless
-    double shaded_fraction[MAXLAY];             // dimensionless
-    double height[MAXLAY];                      // m
-    double canopy_direct_transmission_fraction; // dimensionless
+    Light_profile() {}
+    explicit Light_profile(int nlayers) { resize(nlayers); }
+
+    void resize(int nlayers);
+
+    std::vector<double> sunlit_incident_ppfd;        // micromol / (m^2 leaf) / s
+    std::vector<double> incident_ppfd_scattered;     // micromol / m^2 / s
+    std::vector<double> shaded_incident_ppfd;        // micromol / (m^2 leaf) / s
+    std::vector<double> average_incident_ppfd;       // micromol / (m^2 leaf) / s
+    std::vector<double> sunlit_absorbed_ppfd;        // micromol / (m^2 leaf) / s
+    std::vector<double> shaded_absorbed_ppfd;        // micromol / (m^2 leaf) / s
+    std::vector<double> sunlit_absorbed_shortwave;   // J / (m^2 leaf) / s
+    std::vector<double> shaded_absorbed_shortwave;   // J / (m^2 leaf) / s
+    std::vector<double> average_absorbed_shortwave;  // J / (m^2 leaf) / s
+    std::vector<double> sunlit_fraction;             // dimensionless
+    std::vector<double> shaded_fraction;             // dimensionless
+    std::vector<double> height;                      // m
+    double canopy_direct_transmission_fraction;      // dimensionless
 };
 
 double thin_layer_absorption(
@@ -40,7 +48,7 @@ double absorbed_shortwave_from_incident_ppfd(
     double leaf_reflectance,     // dimensionless
     double leaf_transmittance    // dimensionless
 );
-struct Light_profile sunML(
+void sunML(
     double ambient_ppfd_beam,     // micromol / (m^2 beam) / s
     double ambient_ppfd_diffuse,  // micromol / m^2 / s
     double lai,                   // dimensionless from m^2 / m^2
@@ -53,7 +61,8 @@ struct Light_profile sunML(
     double par_energy_content,    // J / micromol
     double par_energy_fraction,   // dimensionless
     double leaf_transmittance,    // dimensionless
-    double leaf_reflectance       // dimensionless
+    double leaf_reflectance,      // dimensionless
+    Light_profile& light_profile  // outputs
 );
 
 #endif
@@ -0,0 +1,50 @@
+#ifndef SWITCHING_FUNCTIONS_H
+#define SWITCHING_FUNCTIONS_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../framework/state_map.h"  // for string_vector
+
+/**
+ * @brief Describes a threshold where the behavior of a module changes
+ * abruptly, such as the thermal time where a new set of partitioning
+ * coefficients begins to apply.
+ *
+ * The switching function is
+ *
+ * > `value(quantity) - (sum of value(thresholds) + offset)`
+ *
+ * which changes sign when the module switches from one branch to another. For
+ * example, the switching function for the start of the second set of
+ * partitioning coefficients in `partitioning_coefficient_selector` is
+ * `TTc - tp1`, which is described by `{"TTc", {"tp1"}, 0.0}`.
+ *
+ * An adaptive ODE solver that does not know about these thresholds only
+ * discovers them by rejecting steps that cross them. A solver that supports
+ * root finding (such as `lsodar` from the `deSolve` R package) can instead
+ * locate each crossing and restart the integration there, which avoids the
+ * rejected steps and makes the output independent of where the solver's steps
+ * happen to fall. See `system_switching_functions` in the R package.
+ *
+ * Only thresholds involving quantities that change smoothly within a
+ * simulation (typically differential quantities and parameters) are worth
+ * describing this way. Thresholds on drivers such as air temperature are not
+ * included, since the drivers change abruptly at every time point anyway.
+ * Modules that require a fixed-step Euler solver should not declare any, since
+ * they cannot be used with a root-finding solver.
+ */
+struct switching_function {
+    std::string quantity;
+    string_vector thresholds;
+    double offset;
+};
+
+/**
+ * @brief A table of the switching functions for each module that has any,
+ * indexed by module name. Modules that are not in the table have none.
+ */
+using switching_function_map =
+    std::unordered_map<std::string, std::vector<switching_function>>;
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "../framework/module.h"
 #include "../framework/state_map.h"
+#include "growth_history.h"
 
 namespace standardBML
 {
@@ -55,13 +56,16 @@ namespace standardBML
  *  net rate of carbon assimilation due to photosynthesis in its
  *  `assim_rate_XXX_vec` members. When senescence begins for an organ, the
  *  senescence rate is determined from the 0th element of its associated
- *  `assim_rate_XXX_vec` vector. For the next timestep, element 1 is used. So on
+ *  `assim_rate_XXX_vec` history. For the next timestep, element 1 is used. So on
  *  and so forth. This module uses the "senescence index" quantities to keep
- *  track of the index to use for senescence calculations.
+ *  track of the index to use for senescence calculations. Since these indices
+ *  never decrease, elements before the current index are discarded (see
+ *  `growth_history`), so the stored history does not keep growing once
+ *  senescence has begun.
  *
  *  Special care must be taken for the rhizome, since it may begin the
  *  simulation as a carbon source rather than a carbon sink. In this case, the
- *  0th element of the `assim_rate_rhizome_vec` vector would not correspond to
+ *  0th element of the `assim_rate_rhizome_vec` history would not correspond to
  *  the rhizome's first timestep of growth. To account for this, the
  *  `rhizome_senescence_index` must be incremented while it is a carbon source.
  *  Then, when senescence kicks in later, the rhizome senescence index will
@@ -138,15 +142,15 @@ class thermal_time_senescence : public differential_module
     static std::string get_name() { return "thermal_time_senescence"; }
 
    private:
-    // Vectors for storing information about growth history
+    // Storage for information about growth history
     //  Note: this feature is peculiar to this module
     //   and should be avoided in general since it
     //   precludes the use of any integration method
     //   except fixed-step Euler
-    std::vector<double> mutable assim_rate_leaf_vec;
-    std::vector<double> mutable assim_rate_stem_vec;
-    std::vector<double> mutable assim_rate_root_vec;
-    std::vector<double> mutable assim_rate_rhizome_vec;
+    growth_history mutable assim_rate_leaf_vec;
+    growth_history mutable assim_rate_stem_vec;
+    growth_history mutable assim_rate_root_vec;
+    growth_history mutable assim_rate_rhizome_vec;
 
     // Pointers to input quantities
     double const& TTc;
@@ -232,12 +236,19 @@ string_vector thermal_time_senescence::get_outputs()
 
 void thermal_time_senescence::do_operation() const
 {
-    // Add the new tissue growth to the history vectors
+    // Add the new tissue growth to the histories
     assim_rate_leaf_vec.push_back(net_assimilation_rate_leaf);
     assim_rate_stem_vec.push_back(net_assimilation_rate_stem);
     assim_rate_root_vec.push_back(net_assimilation_rate_root);
     assim_rate_rhizome_vec.push_back(net_assimilation_rate_rhizome);
 
+    // Values recorded before the current senescence indices will never be
+    // used again, since the indices can only increase
+    assim_rate_leaf_vec.discard_before(leaf_senescence_index);
+    assim_rate_stem_vec.discard_before(stem_senescence_index);
+    assim_rate_root_vec.discard_before(root_senescence_index);
+    assim_rate_rhizome_vec.discard_before(rhizome_senescence_index);
+
     // Initialize variables
     double dLeaf{0.0};
     double dStem{0.0};
@@ -54,7 +54,10 @@ class two_layer_soil_profile : public differential_module
           // Get pointers to output quantities
           cws1_op{get_op(output_quantities, "cws1")},
           cws2_op{get_op(output_quantities, "cws2")},
-          soil_water_content_op{get_op(output_quantities, "soil_water_content")}
+          soil_water_content_op{get_op(output_quantities, "soil_water_content")},
+
+          // Allocate storage for the soil profile
+          soil_profile{2}
     {
     }
     static string_vector get_inputs();
@@ -102,6 +105,9 @@ class two_layer_soil_profile : public differential_module
     double* cws2_op;
     double* soil_water_content_op;
 
+    // Storage for the soil profile, reused every time the module runs
+    soilML_str mutable soil_profile;
+
     // Main operation
     void do_operation() const;
 };
@@ -160,25 +166,25 @@ void two_layer_soil_profile::do_operation() const
     double cws[] = {cws1, cws2};
     double soil_depths[] = {soil_depth1, soil_depth2, soil_depth3};
 
-    struct soilML_str soilMLS = soilML(
+    soilML(
         precip, canopy_transpiration_rate, cws, soil_depth3, soil_depths,
         soil_field_capacity, soil_wilting_point, soil_saturation_capacity,
         soil_air_entry, soil_saturated_conductivity, soil_b_coefficient,
         soil_sand_content, phi1, phi2, wsFun, 2 /* Always uses 2 layers */,
         Root, lai, 0.68, temp, solar, windspeed, rh, hydrDist, rfl, rsec, rsdf,
         soil_clod_size, soil_reflectance, soil_transmission,
-        specific_heat_of_air, par_energy_content);
+        specific_heat_of_air, par_energy_content, soil_profile);
 
     double layer_one_depth = soil_depth2 - soil_depth1;
     double layer_two_depth = soil_depth3 - soil_depth2;
 
     double cws_mean =
-        (soilMLS.cws[0] * layer_one_depth + soilMLS.cws[1] * layer_two_depth) /
+        (soil_profile.cws[0] * layer_one_depth + soil_profile.cws[1] * layer_two_depth) /
         (layer_one_depth + layer_two_depth);
 
     // Update the output quantity list
-    update(cws1_op, soilMLS.cws[0] - cws1);
-    update(cws2_op, soilMLS.cws[1] - cws2);
+    update(cws1_op, soil_profile.cws[0] - cws1);
+    update(cws2_op, soil_profile.cws[1] - cws2);
     update(soil_water_content_op, cws_mean - soil_water_content);
 }
 
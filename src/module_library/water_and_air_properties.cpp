@@ -0,0 +1,105 @@
+#include <algorithm>  // for std::min
+#include <cmath>      // for floor
+#include <vector>
+#include "water_and_air_properties.h"
+
+namespace
+{
+// Range and spacing of the temperatures in the saturation vapor pressure table
+double constexpr swvp_table_min_temperature = -40.0;  // degrees C
+double constexpr swvp_table_max_temperature = 60.0;   // degrees C
+double constexpr swvp_table_step = 0.5;               // degrees C
+int constexpr swvp_table_intervals = 200;             // (max - min) / step
+
+static_assert(
+    swvp_table_intervals * swvp_table_step ==
+        swvp_table_max_temperature - swvp_table_min_temperature,
+    "The saturation vapor pressure table must cover its temperature range");
+
+/**
+ *  @brief Cubic polynomials that approximate `saturation_vapor_pressure()` on
+ *  each interval of the table.
+ *
+ *  On each interval, the polynomial is the cubic Hermite interpolant that
+ *  matches the value and slope of the Arden Buck equation at both ends of the
+ *  interval. The error of such an interpolant is at most `h^4 / 384` times the
+ *  largest magnitude of the fourth derivative on the interval, where `h` is
+ *  the interval width. For the Arden Buck equation, the fourth derivative is
+ *  less than `6e-5` times the saturation vapor pressure itself over the range
+ *  of the table (the largest values occur at the lowest temperatures), so with
+ *  `h = 0.5` degrees C the relative error is less than `1e-8`.
+ */
+struct swvp_table {
+    swvp_table()
+    {
+        int const n_intervals = swvp_table_intervals;
+
+        coefficients.reserve(4 * n_intervals);
+
+        // Returns the value and the derivative of the Arden Buck equation with
+        // respect to temperature (multiplied by the interval width)
+        auto value_and_scaled_slope = [](double T, double& value, double& slope) {
+            double const a = (18.678 - T / 234.5) * T;
+            double const b = 257.14 + T;
+            double const da = 18.678 - 2 * T / 234.5;
+            value = saturation_vapor_pressure(T);
+            slope = value * (da * b - a) / (b * b) * swvp_table_step;
+        };
+
+        for (int i = 0; i < n_intervals; ++i) {
+            double y0, d0, y1, d1;
+            value_and_scaled_slope(swvp_table_min_temperature + i * swvp_table_step, y0, d0);
+            value_and_scaled_slope(swvp_table_min_temperature + (i + 1) * swvp_table_step, y1, d1);
+
+            // Coefficients of p(s) = c0 + c1 * s + c2 * s^2 + c3 * s^3 for
+            // 0 <= s <= 1
+            coefficients.push_back(y0);
+            coefficients.push_back(d0);
+            coefficients.push_back(3 * (y1 - y0) - 2 * d0 - d1);
+            coefficients.push_back(2 * (y0 - y1) + d0 + d1);
+        }
+    }
+
+    std::vector<double> coefficients;
+};
+}  // namespace
+
+/**
+ *  @brief Determine saturation water vapor pressure (Pa) from air temperature
+ *  (degrees C) using a table of piecewise cubic approximations to the Arden
+ *  Buck equation.
+ *
+ *  Between -40 and 60 degrees C, the result differs from
+ *  `saturation_vapor_pressure()` by a relative error of less than 1e-8, and it
+ *  is calculated without evaluating any exponential functions. Outside that
+ *  range, `saturation_vapor_pressure()` is used directly.
+ *
+ *  The table is created the first time this function is called and is never
+ *  modified afterwards, so this function can be called from several threads at
+ *  once.
+ *
+ *  @param [in] air_temperature Air temperature in degrees C
+ *
+ *  @return Saturation water vapor pressure in Pa
+ */
+double saturation_vapor_pressure_tabulated(
+    double air_temperature  // degrees C
+)
+{
+    if (!(air_temperature >= swvp_table_min_temperature &&
+          air_temperature < swvp_table_max_temperature)) {
+        return saturation_vapor_pressure(air_temperature);  // Pa
+    }
+
+    static swvp_table const table;
+
+    // Just below the maximum temperature, `x` can round up to the number of
+    // intervals, so the last interval is also used in that case
+    double const x = (air_temperature - swvp_table_min_temperature) / swvp_table_step;
+    double const i = std::min(floor(x), swvp_table_intervals - 1.0);
+    double const s = x - i;
+
+    double const* c = &table.coefficients[4 * static_cast<size_t>(i)];
+
+    return c[0] + s * (c[1] + s * (c[2] + s * c[3]));  // Pa
+}
@@ -36,6 +36,21 @@ inline double saturation_vapor_pressure(
     return 611.21 * exp(a / b);  // Pa
 }
 
+double saturation_vapor_pressure_tabulated(
+    double air_temperature  // degrees C
+);
+
+/**
+ *  @brief A function that determines saturation water vapor pressure (Pa) from
+ *  air temperature (degrees C).
+ *
+ *  Functions that need saturation water vapor pressure many times per call,
+ *  such as `EvapoTrans2()` and `ball_berry_gs()`, accept one of these as an
+ *  optional final argument. It defaults to `saturation_vapor_pressure()`, and
+ *  modules can pass `saturation_vapor_pressure_tabulated()` instead.
+ */
+using saturation_vapor_pressure_function = double (*)(double);
+
 /**
  *  @brief Determines the density of dry air from the air temperature.
  *
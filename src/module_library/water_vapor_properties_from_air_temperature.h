@@ -3,7 +3,7 @@
 
 #include "../framework/module.h"
 #include "../framework/state_map.h"
-#include "water_and_air_properties.h"  // for saturation_vapor_pressure,
+#include "water_and_air_properties.h"  // for saturation_vapor_pressure_function,
                                        // TempToSFS, TempToLHV, TempToDdryA
 #include "../framework/constants.h"    // for ideal_gas_constant,
                                        // molar_mass_of_water, celsius_to_kelvin
@@ -15,7 +15,8 @@ class water_vapor_properties_from_air_temperature : public direct_module
    public:
     water_vapor_properties_from_air_temperature(
         state_map const& input_quantities,
-        state_map* output_quantities)
+        state_map* output_quantities,
+        saturation_vapor_pressure_function swvp = saturation_vapor_pressure)
         : direct_module{},
 
           // Get references to input quantities
@@ -29,7 +30,9 @@ class water_vapor_properties_from_air_temperature : public direct_module
           saturation_water_vapor_pressure_op{get_op(output_quantities, "saturation_water_vapor_pressure")},
           water_vapor_pressure_op{get_op(output_quantities, "water_vapor_pressure")},
           vapor_density_deficit_op{get_op(output_quantities, "vapor_density_deficit")},
-          psychrometric_parameter_op{get_op(output_quantities, "psychrometric_parameter")}
+          psychrometric_parameter_op{get_op(output_quantities, "psychrometric_parameter")},
+
+          swvp{swvp}
     {
     }
     static string_vector get_inputs();
@@ -50,6 +53,9 @@ class water_vapor_properties_from_air_temperature : public direct_module
     double* vapor_density_deficit_op;
     double* psychrometric_parameter_op;
 
+    // Function used to calculate saturation water vapor pressure
+    saturation_vapor_pressure_function const swvp;
+
     // Main operation
     void do_operation() const;
 };
@@ -79,9 +85,9 @@ void water_vapor_properties_from_air_temperature::do_operation() const
 {
     // Collect input quantities and make calculations
 
-    double density_of_dry_air = TempToDdryA(temp);                             // kg / m^3
-    double latent_heat_vaporization_of_water = TempToLHV(temp);                // J / kg
-    double saturation_water_vapor_pressure = saturation_vapor_pressure(temp);  // Pa
+    double density_of_dry_air = TempToDdryA(temp);               // kg / m^3
+    double latent_heat_vaporization_of_water = TempToLHV(temp);  // J / kg
+    double saturation_water_vapor_pressure = swvp(temp);         // Pa
 
     // Convert saturation water vapor pressure to vapor density using the ideal
     // gas law. This is approximately right for temperatures what won't kill
@@ -106,5 +112,30 @@ void water_vapor_properties_from_air_temperature::do_operation() const
     update(psychrometric_parameter_op, psychrometric_parameter);                      // kg / m^3 / K
 }
 
+/**
+ * @class water_vapor_properties_from_air_temperature_tabulated_swvp
+ *
+ * @brief Identical to `water_vapor_properties_from_air_temperature`, except
+ * that saturation water vapor pressure is calculated by
+ * `saturation_vapor_pressure_tabulated()` rather than
+ * `saturation_vapor_pressure()`. It can be used to provide the inputs to
+ * `penman_monteith_leaf_temperature`, which does not calculate saturation water
+ * vapor pressure itself.
+ */
+class water_vapor_properties_from_air_temperature_tabulated_swvp : public water_vapor_properties_from_air_temperature
+{
+   public:
+    water_vapor_properties_from_air_temperature_tabulated_swvp(
+        state_map const& input_quantities,
+        state_map* output_quantities)
+        : water_vapor_properties_from_air_temperature{
+              input_quantities,
+              output_quantities,
+              saturation_vapor_pressure_tabulated}
+    {
+    }
+    static std::string get_name() { return "water_vapor_properties_from_air_temperature_tabulated_swvp"; }
+};
+
 }  // namespace standardBML
 #endif
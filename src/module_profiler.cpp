@@ -0,0 +1,111 @@
+#include <chrono>                // for std::chrono::steady_clock
+#include <algorithm>             // for std::max
+#include <utility>               // for std::move
+#include "framework/module.h"    // for module, direct_module, differential_module
+#include "module_profiler.h"
+
+namespace
+{
+/**
+ *  @brief Runs a module and adds the elapsed wall time to its statistics
+ */
+void timed_run(module const& m, module_timing* timing)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    m.run();
+
+    std::chrono::duration<double> const elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    ++timing->calls;
+    timing->total_seconds += elapsed.count();
+    timing->max_seconds = std::max(timing->max_seconds, elapsed.count());
+}
+
+/**
+ *  @brief Wraps a direct module, timing each of its runs. The wrapped module
+ *  sets its own outputs, so this module never calls `update()`.
+ */
+class profiled_direct_module : public direct_module
+{
+   public:
+    profiled_direct_module(
+        std::unique_ptr<module> wrapped,
+        module_timing* timing)
+        : direct_module{},
+          wrapped{std::move(wrapped)},
+          timing{timing}
+    {
+    }
+
+   private:
+    std::unique_ptr<module> const wrapped;
+    module_timing* const timing;
+
+    void do_operation() const override { timed_run(*wrapped, timing); }
+};
+
+/**
+ *  @brief Wraps a differential module, timing each of its runs. The wrapped
+ *  module sets its own outputs, so this module never calls `update()`.
+ */
+class profiled_differential_module : public differential_module
+{
+   public:
+    profiled_differential_module(
+        std::unique_ptr<module> wrapped,
+        module_timing* timing)
+        : differential_module{wrapped->requires_euler_ode_solver()},
+          wrapped{std::move(wrapped)},
+          timing{timing}
+    {
+    }
+
+   private:
+    std::unique_ptr<module> const wrapped;
+    module_timing* const timing;
+
+    void do_operation() const override { timed_run(*wrapped, timing); }
+};
+
+}  // namespace
+
+std::unique_ptr<module> profiling_module_creator::create_module(
+    state_map const& input_quantities,
+    state_map* output_quantities)
+{
+    std::unique_ptr<module> m =
+        wrapped->create_module(input_quantities, output_quantities);
+
+    if (m->is_differential()) {
+        return std::unique_ptr<module>(
+            new profiled_differential_module(std::move(m), &timing));
+    }
+
+    return std::unique_ptr<module>(
+        new profiled_direct_module(std::move(m), &timing));
+}
+
+mc_vector module_profiler::wrap(mc_vector const& mcs)
+{
+    mc_vector wrapped_mcs;
+
+    for (module_creator* mc : mcs) {
+        creators.emplace_back(new profiling_module_creator(mc));
+        wrapped_mcs.push_back(creators.back().get());
+    }
+
+    return wrapped_mcs;
+}
+
+std::vector<module_timing> module_profiler::get_timings() const
+{
+    std::vector<module_timing> timings;
+
+    for (auto const& mc : creators) {
+        timings.push_back(mc->get_timing());
+    }
+
+    return timings;
+}
@@ -0,0 +1,77 @@
+#ifndef MODULE_PROFILER_H
+#define MODULE_PROFILER_H
+
+#include <memory>                      // for std::unique_ptr
+#include <string>
+#include <vector>
+#include "framework/module_creator.h"  // for module_creator, mc_vector
+#include "framework/state_map.h"       // for state_map, string_vector
+
+/**
+ *  @brief Run-time statistics for all of the modules created by one module
+ *  creator
+ */
+struct module_timing {
+    size_t calls = 0;            // number of times a module was run
+    double total_seconds = 0.0;  // cumulative wall time spent in the module
+    double max_seconds = 0.0;    // longest wall time for a single run
+};
+
+/**
+ *  @class profiling_module_creator
+ *
+ *  @brief A module creator that wraps another module creator, recording how
+ *  many times the modules it creates are run and how long they take.
+ *
+ *  The wrapped creator is used for everything else, so a system built from
+ *  profiling module creators behaves exactly like one built from the original
+ *  creators. The wrapped creator is not owned by this object and must remain
+ *  valid for as long as it is in use.
+ */
+class profiling_module_creator : public module_creator
+{
+   public:
+    explicit profiling_module_creator(module_creator* wrapped)
+        : wrapped{wrapped}
+    {
+    }
+
+    std::unique_ptr<module> create_module(
+        state_map const& input_quantities,
+        state_map* output_quantities) override;
+
+    string_vector get_inputs() override { return wrapped->get_inputs(); }
+    string_vector get_outputs() override { return wrapped->get_outputs(); }
+    std::string get_name() override { return wrapped->get_name(); }
+
+    module_timing const& get_timing() const { return timing; }
+
+   private:
+    module_creator* const wrapped;
+    module_timing timing;
+};
+
+/**
+ *  @class module_profiler
+ *
+ *  @brief Owns a `profiling_module_creator` for each module creator used by a
+ *  simulation.
+ *
+ *  Profiling is opt-in: a simulation is only instrumented when it is built from
+ *  the creators returned by `wrap()`, so there is no cost when the original
+ *  creators are used directly.
+ */
+class module_profiler
+{
+   public:
+    mc_vector wrap(mc_vector const& mcs);
+
+    // Timing statistics for every wrapped creator, in the order they were
+    // wrapped
+    std::vector<module_timing> get_timings() const;
+
+   private:
+    std::vector<std::unique_ptr<profiling_module_creator>> creators;
+};
+
+#endif
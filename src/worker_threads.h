@@ -0,0 +1,66 @@
+#ifndef WORKER_THREADS_H
+#define WORKER_THREADS_H
+
+#include <algorithm>  // for std::min, std::max
+#include <cmath>      // for std::isfinite
+#include <stdexcept>  // for std::runtime_error
+#include <thread>     // for std::thread
+#include <vector>
+
+/**
+ *  @brief Determines how many threads should be used to process `n_items`
+ *  items when `requested_threads` threads have been requested; values less
+ *  than 1 indicate that the number of threads should be chosen automatically.
+ *
+ *  The result is always at least 1 and never more than `n_items` (unless
+ *  `n_items` is 0).
+ */
+inline size_t worker_count(double requested_threads, size_t n_items)
+{
+    if (!std::isfinite(requested_threads)) {
+        throw std::runtime_error("The number of threads must be a finite number");
+    }
+
+    size_t requested = requested_threads < 1
+                           ? std::thread::hardware_concurrency()
+                           : static_cast<size_t>(requested_threads);
+
+    return std::min(
+        std::max(requested, static_cast<size_t>(1)),
+        std::max(n_items, static_cast<size_t>(1)));
+}
+
+/**
+ *  @brief Runs `worker` on `n_workers` threads, one of which is the calling
+ *  thread, and returns once all of them have finished.
+ *
+ *  Any threads that were started are joined before this function returns,
+ *  even if starting another thread fails; in that case, the exception thrown
+ *  by `std::thread` is passed on after the joins. `worker` itself must not
+ *  throw, so it should catch and store any errors for its items.
+ */
+template <typename F>
+void run_on_worker_threads(size_t n_workers, F const& worker)
+{
+    struct joining_pool {
+        std::vector<std::thread> threads;
+
+        ~joining_pool()
+        {
+            for (std::thread& t : threads) {
+                if (t.joinable()) {
+                    t.join();
+                }
+            }
+        }
+    } pool;
+
+    pool.threads.reserve(n_workers);
+    for (size_t w = 1; w < n_workers; ++w) {
+        pool.threads.emplace_back(worker);
+    }
+
+    worker();  // the calling thread also does some of the work
+}
+
+#endif
@@ -0,0 +1,178 @@
+// A command-line program that runs a BioCro simulation without R.
+//
+// Usage:
+//
+//   biocro-run [--verbose] SIMULATION_JSON DRIVERS_CSV OUTPUT_CSV
+//
+// See README.md in this directory for a description of the input and output
+// file formats.
+
+#include <cmath>      // for std::floor
+#include <exception>  // for std::exception
+#include <iostream>   // for std::cout, std::cerr
+#include <memory>     // for std::unique_ptr
+#include <string>
+#include <vector>
+#include "../src/framework/biocro_simulation.h"
+#include "../src/framework/module_creator.h"  // for module_creator, mc_vector
+#include "../src/framework/module_factory.h"
+#include "../src/framework/state_map.h"  // for state_map, state_vector_map
+#include "../src/module_library/module_library.h"
+#include "csv_io.h"
+#include "json_reader.h"
+
+using std::string;
+using std::vector;
+using library = standardBML::module_library;
+
+namespace
+{
+// R module names include the name of their library, as in
+// `BioCro:thermal_time_linear`, but the module factory expects only the module
+// name itself
+string const library_prefix = "BioCro:";
+
+state_map map_from_json_object(json_value const& object)
+{
+    state_map result;
+    for (auto const& member : object.members()) {
+        result[member.first] = member.second.as_number();
+    }
+    return result;
+}
+
+/**
+ *  @brief Creates module creators for the module names in a JSON array; the
+ *  returned `owners` vector is responsible for deleting them.
+ */
+mc_vector module_creators_from_json_array(
+    json_value const& names,
+    vector<std::unique_ptr<module_creator>>& owners)
+{
+    mc_vector result;
+    for (json_value const& name : names.elements()) {
+        string module_name = name.text;
+        if (module_name.compare(0, library_prefix.size(), library_prefix) == 0) {
+            module_name = module_name.substr(library_prefix.size());
+        }
+
+        module_creator* mc = module_factory<library>::retrieve(module_name);
+        owners.emplace_back(mc);
+        result.push_back(mc);
+    }
+    return result;
+}
+
+/**
+ *  @brief If the drivers have `doy` and `hour` columns but no `time` column,
+ *  adds one; this mirrors `add_time_to_weather_data()` in the R package.
+ */
+void add_time_to_drivers(state_vector_map& drivers)
+{
+    if (drivers.count("doy") && drivers.count("hour") && !drivers.count("time")) {
+        vector<double> const& doy = drivers.at("doy");
+        vector<double> const& hour = drivers.at("hour");
+        vector<double> time(doy.size());
+        for (size_t i = 0; i < time.size(); ++i) {
+            time[i] = doy[i] + hour[i] / 24.0;
+        }
+        drivers["time"] = time;
+    }
+}
+
+/**
+ *  @brief Adds `doy` and `hour` columns computed from `time`; this mirrors the
+ *  formatting applied by `run_biocro()` in the R package.
+ */
+void add_doy_and_hour_to_result(state_vector_map& result)
+{
+    vector<double> const& time = result.at("time");
+    vector<double> doy(time.size());
+    vector<double> hour(time.size());
+    for (size_t i = 0; i < time.size(); ++i) {
+        doy[i] = std::floor(time[i]);
+        hour[i] = 24.0 * (time[i] - doy[i]);
+    }
+    result["doy"] = doy;
+    result["hour"] = hour;
+}
+
+void print_usage()
+{
+    std::cerr << "Usage: biocro-run [--verbose] SIMULATION_JSON DRIVERS_CSV OUTPUT_CSV\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    bool verbose = false;
+    vector<string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        string const arg = argv[i];
+        if (arg == "--verbose") {
+            verbose = true;
+        } else if (arg == "--help") {
+            print_usage();
+            return 0;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.size() != 3) {
+        print_usage();
+        return 2;
+    }
+
+    try {
+        json_value const simulation = read_json_file(files[0]);
+
+        state_map const initial_values =
+            map_from_json_object(simulation.at("initial_values"));
+
+        state_map const parameters =
+            map_from_json_object(simulation.at("parameters"));
+
+        state_vector_map drivers = read_csv_columns(files[1]);
+        add_time_to_drivers(drivers);
+
+        if (drivers.empty() || drivers.begin()->second.empty()) {
+            throw std::runtime_error("The drivers cannot be empty");
+        }
+
+        vector<std::unique_ptr<module_creator>> owners;
+
+        mc_vector const direct_mcs = module_creators_from_json_array(
+            simulation.at("direct_modules"), owners);
+
+        mc_vector const differential_mcs = module_creators_from_json_array(
+            simulation.at("differential_modules"), owners);
+
+        json_value const& ode_solver = simulation.at("ode_solver");
+
+        biocro_simulation gro(
+            initial_values, parameters, drivers, direct_mcs, differential_mcs,
+            ode_solver.at("type").text,
+            ode_solver.at("output_step_size").as_number(),
+            ode_solver.at("adaptive_rel_error_tol").as_number(),
+            ode_solver.at("adaptive_abs_error_tol").as_number(),
+            static_cast<int>(ode_solver.at("adaptive_max_steps").as_number()));
+
+        state_vector_map result = gro.run_simulation();
+
+        if (verbose) {
+            std::cout << gro.generate_report();
+        }
+
+        add_doy_and_hour_to_result(result);
+        write_csv_columns(result, files[2]);
+
+    } catch (std::exception const& e) {
+        std::cerr << "biocro-run: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include <algorithm>  // for std::sort
+#include <cmath>      // for std::isnan
+#include <cstdlib>    // for std::strtod
+#include <fstream>    // for std::ifstream, std::ofstream
+#include <limits>     // for std::numeric_limits
+#include <sstream>    // for std::istringstream
+#include <stdexcept>  // for std::runtime_error
+#include <vector>
+#include "csv_io.h"
+
+using std::string;
+using std::vector;
+
+namespace
+{
+vector<string> split_line(string const& line)
+{
+    vector<string> fields;
+    std::istringstream stream(line);
+    string field;
+    while (std::getline(stream, field, ',')) {
+        // Remove surrounding whitespace, carriage returns, and quotes
+        size_t const first = field.find_first_not_of(" \t\r\"");
+        size_t const last = field.find_last_not_of(" \t\r\"");
+        fields.push_back(
+            first == string::npos ? "" : field.substr(first, last - first + 1));
+    }
+    return fields;
+}
+
+double parse_field(string const& field, string const& filename, size_t line_number)
+{
+    if (field.empty() || field == "NA" || field == "NaN") {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    char* end = nullptr;
+    double const value = std::strtod(field.c_str(), &end);
+
+    if (*end != '\0') {
+        throw std::runtime_error(
+            "Non-numeric value `" + field + "` on line " +
+            std::to_string(line_number) + " of `" + filename + "`");
+    }
+
+    return value;
+}
+
+}  // namespace
+
+/**
+ *  @brief Reads a comma-separated file whose first line contains column names
+ *  and whose remaining lines contain numeric values, returning the columns.
+ *
+ *  Missing values can be indicated by empty fields, `NA`, or `NaN`, and are
+ *  read as NaN.
+ */
+state_vector_map read_csv_columns(string const& filename)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not open `" + filename + "`");
+    }
+
+    string line;
+    if (!std::getline(file, line)) {
+        throw std::runtime_error("`" + filename + "` is empty");
+    }
+
+    vector<string> const names = split_line(line);
+    vector<vector<double>> columns(names.size());
+
+    size_t line_number = 1;
+    while (std::getline(file, line)) {
+        ++line_number;
+
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;  // skip blank lines
+        }
+
+        vector<string> const fields = split_line(line);
+
+        if (fields.size() != names.size()) {
+            throw std::runtime_error(
+                "Line " + std::to_string(line_number) + " of `" + filename +
+                "` has " + std::to_string(fields.size()) + " fields, but " +
+                std::to_string(names.size()) + " were expected");
+        }
+
+        for (size_t i = 0; i < fields.size(); ++i) {
+            columns[i].push_back(parse_field(fields[i], filename, line_number));
+        }
+    }
+
+    state_vector_map result;
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (!result.emplace(names[i], std::move(columns[i])).second) {
+            throw std::runtime_error(
+                "`" + filename + "` contains more than one column named `" +
+                names[i] + "`");
+        }
+    }
+
+    return result;
+}
+
+/**
+ *  @brief Writes columns of numbers to a comma-separated file, with the column
+ *  names sorted alphabetically in the first line.
+ *
+ *  All columns are assumed to have the same length, as they do in the output
+ *  from `biocro_simulation::run_simulation()`. NaN values are written as `NA`
+ *  so the file can be read directly by R.
+ */
+void write_csv_columns(state_vector_map const& columns, string const& filename)
+{
+    std::ofstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not open `" + filename + "` for writing");
+    }
+
+    vector<string> names;
+    for (auto const& column : columns) {
+        names.push_back(column.first);
+    }
+    std::sort(names.begin(), names.end());
+
+    vector<vector<double> const*> ordered;
+    for (string const& name : names) {
+        ordered.push_back(&columns.at(name));
+    }
+
+    size_t const n_rows = ordered.empty() ? 0 : ordered[0]->size();
+
+    file.precision(std::numeric_limits<double>::max_digits10);
+
+    for (size_t j = 0; j < names.size(); ++j) {
+        file << (j == 0 ? "" : ",") << names[j];
+    }
+    file << '\n';
+
+    for (size_t i = 0; i < n_rows; ++i) {
+        for (size_t j = 0; j < ordered.size(); ++j) {
+            double const value = (*ordered[j])[i];
+            file << (j == 0 ? "" : ",");
+            if (std::isnan(value)) {
+                file << "NA";
+            } else {
+                file << value;
+            }
+        }
+        file << '\n';
+    }
+
+    if (!file) {
+        throw std::runtime_error("An error occurred while writing `" + filename + "`");
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef CSV_IO_H
+#define CSV_IO_H
+
+#include <string>
+#include "../src/framework/state_map.h"  // for state_vector_map
+
+state_vector_map read_csv_columns(std::string const& filename);
+
+void write_csv_columns(
+    state_vector_map const& columns,
+    std::string const& filename);
+
+#endif
@@ -0,0 +1,273 @@
+#include <cctype>     // for std::isspace, std::isdigit
+#include <cstdlib>    // for std::strtod
+#include <fstream>    // for std::ifstream
+#include <limits>     // for std::numeric_limits
+#include <memory>     // for std::make_shared
+#include <sstream>    // for std::stringstream
+#include <stdexcept>  // for std::runtime_error
+#include "json_reader.h"
+
+using std::string;
+
+namespace
+{
+/**
+ *  @brief A simple recursive-descent parser for JSON documents.
+ */
+class json_parser
+{
+   public:
+    json_parser(string const& text) : text{text} {}
+
+    json_value parse_document()
+    {
+        json_value result = parse_value();
+        skip_whitespace();
+        if (pos != text.size()) {
+            error("unexpected characters after the end of the document");
+        }
+        return result;
+    }
+
+   private:
+    string const& text;
+    size_t pos = 0;
+
+    [[noreturn]] void error(string const& message) const
+    {
+        throw std::runtime_error(
+            "Error parsing JSON at character " + std::to_string(pos) + ": " +
+            message);
+    }
+
+    void skip_whitespace()
+    {
+        while (pos < text.size() &&
+               std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+    }
+
+    char peek()
+    {
+        skip_whitespace();
+        if (pos >= text.size()) {
+            error("unexpected end of document");
+        }
+        return text[pos];
+    }
+
+    void expect(char c)
+    {
+        if (peek() != c) {
+            error(string("expected '") + c + "'");
+        }
+        ++pos;
+    }
+
+    bool consume_literal(string const& literal)
+    {
+        if (text.compare(pos, literal.size(), literal) == 0) {
+            pos += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    json_value parse_value()
+    {
+        json_value v;
+        char const c = peek();
+
+        if (c == '{') {
+            v.type = json_value::kind::object;
+            v.object_members = std::make_shared<json_value::object_type const>(parse_object());
+        } else if (c == '[') {
+            v.type = json_value::kind::array;
+            v.array_elements = std::make_shared<json_value::array_type const>(parse_array());
+        } else if (c == '"') {
+            v.type = json_value::kind::string;
+            v.text = parse_string();
+        } else if (consume_literal("true")) {
+            v.type = json_value::kind::boolean;
+            v.boolean = true;
+        } else if (consume_literal("false")) {
+            v.type = json_value::kind::boolean;
+            v.boolean = false;
+        } else if (consume_literal("null")) {
+            v.type = json_value::kind::null;
+        } else {
+            v.type = json_value::kind::number;
+            v.number = parse_number();
+        }
+
+        return v;
+    }
+
+    json_value::object_type parse_object()
+    {
+        json_value::object_type members;
+        expect('{');
+        if (peek() == '}') {
+            ++pos;
+            return members;
+        }
+        while (true) {
+            if (peek() != '"') {
+                error("expected a string key");
+            }
+            string key = parse_string();
+            expect(':');
+            members.emplace_back(key, parse_value());
+            if (peek() == ',') {
+                ++pos;
+            } else {
+                expect('}');
+                return members;
+            }
+        }
+    }
+
+    json_value::array_type parse_array()
+    {
+        json_value::array_type elements;
+        expect('[');
+        if (peek() == ']') {
+            ++pos;
+            return elements;
+        }
+        while (true) {
+            elements.push_back(parse_value());
+            if (peek() == ',') {
+                ++pos;
+            } else {
+                expect(']');
+                return elements;
+            }
+        }
+    }
+
+    string parse_string()
+    {
+        expect('"');
+        string result;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\') {
+                if (pos >= text.size()) {
+                    break;
+                }
+                char const escaped = text[pos++];
+                switch (escaped) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': error("unicode escapes are not supported");
+                    default: c = escaped;  // handles \", \\, and \/
+                }
+            }
+            result += c;
+        }
+        if (pos >= text.size()) {
+            error("unterminated string");
+        }
+        ++pos;  // skip the closing quote
+        return result;
+    }
+
+    double parse_number()
+    {
+        char const* start = text.c_str() + pos;
+        char* end = nullptr;
+        double const result = std::strtod(start, &end);
+        if (end == start) {
+            error("expected a value");
+        }
+        pos += end - start;
+        return result;
+    }
+};
+
+}  // namespace
+
+/**
+ *  @brief Returns the elements of a JSON array, which are empty for any other
+ *  kind of value.
+ */
+json_value::array_type const& json_value::elements() const
+{
+    static array_type const empty;
+    return array_elements ? *array_elements : empty;
+}
+
+/**
+ *  @brief Returns the members of a JSON object, which are empty for any other
+ *  kind of value.
+ */
+json_value::object_type const& json_value::members() const
+{
+    static object_type const empty;
+    return object_members ? *object_members : empty;
+}
+
+/**
+ *  @brief Returns the value associated with `key` in a JSON object, throwing
+ *  an exception if the key is not present.
+ */
+json_value const& json_value::at(string const& key) const
+{
+    for (auto const& member : members()) {
+        if (member.first == key) {
+            return member.second;
+        }
+    }
+    throw std::runtime_error("Required JSON key `" + key + "` was not found");
+}
+
+/**
+ *  @brief Checks whether a JSON object contains `key`.
+ */
+bool json_value::has(string const& key) const
+{
+    for (auto const& member : members()) {
+        if (member.first == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ *  @brief Interprets a JSON value as a number, where `null` becomes NaN.
+ */
+double json_value::as_number() const
+{
+    switch (type) {
+        case kind::number:
+            return number;
+        case kind::null:
+            return std::numeric_limits<double>::quiet_NaN();
+        case kind::boolean:
+            return boolean ? 1.0 : 0.0;
+        default:
+            throw std::runtime_error("A JSON value is not a number");
+    }
+}
+
+json_value parse_json(string const& text)
+{
+    return json_parser(text).parse_document();
+}
+
+json_value read_json_file(string const& filename)
+{
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not open `" + filename + "`");
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parse_json(buffer.str());
+}
@@ -0,0 +1,47 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <memory>   // for std::shared_ptr
+#include <string>
+#include <utility>  // for std::pair
+#include <vector>
+
+/**
+ *  @brief A value read from a JSON document.
+ *
+ *  Only the features of JSON needed to describe a BioCro simulation are
+ *  supported: objects, arrays, strings, numbers, booleans, and `null`. A `null`
+ *  value is interpreted as a number equal to NaN, which matches the way `NA`
+ *  values are passed from R to C++.
+ *
+ *  The elements of arrays and the members of objects are held through
+ *  pointers, since standard library containers are only guaranteed to accept
+ *  an incomplete element type (like `json_value` inside its own definition)
+ *  from C++17 onward. Values are not modified after they are parsed, so
+ *  copies of a value share its elements and members.
+ */
+struct json_value {
+    enum class kind { null, boolean, number, string, array, object };
+
+    using array_type = std::vector<json_value>;
+    using object_type = std::vector<std::pair<std::string, json_value>>;
+
+    kind type = kind::null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::shared_ptr<array_type const> array_elements;
+    std::shared_ptr<object_type const> object_members;
+
+    array_type const& elements() const;
+    object_type const& members() const;
+    json_value const& at(std::string const& key) const;
+    bool has(std::string const& key) const;
+    double as_number() const;
+};
+
+json_value parse_json(std::string const& text);
+
+json_value read_json_file(std::string const& filename);
+
+#endif
@@ -0,0 +1,178 @@
+#include <cmath>      // for std::isnan
+#include <cstdio>     // for std::remove
+#include <iostream>   // for std::cout, std::cerr
+#include <limits>     // for std::numeric_limits
+#include <stdexcept>  // for std::runtime_error
+#include <string>
+#include "../csv_io.h"
+#include "../json_reader.h"
+
+// Tests for the JSON and CSV readers and writers used by `biocro-run`. When a
+// file name is supplied, it is read as the output of `write_json_test.R` and
+// compared against the values written there.
+//
+// Usage: io_test [WRITER_OUTPUT_JSON]
+
+using std::string;
+
+namespace
+{
+int failures = 0;
+
+void check(bool condition, string const& description)
+{
+    if (!condition) {
+        std::cerr << "FAILED: " << description << '\n';
+        ++failures;
+    }
+}
+
+void check_parse_error(string const& text, string const& description)
+{
+    try {
+        parse_json(text);
+        check(false, description + " (no error was thrown)");
+    } catch (std::runtime_error const&) {
+    }
+}
+
+void test_json_reader()
+{
+    json_value const v = parse_json(
+        " { \"a\": 1.5, \"b\": [true, false, null, -2e-3],"
+        " \"c\": {}, \"d\": [], \"e\": \"x\\\"y\\\\z\\n\" } ");
+
+    check(v.type == json_value::kind::object, "a document can be an object");
+    check(v.members().size() == 5, "objects keep all of their members");
+    check(v.at("a").as_number() == 1.5, "numbers are read");
+    check(v.has("c") && !v.has("f"), "has() finds only keys that are present");
+
+    json_value::array_type const& b = v.at("b").elements();
+    check(b.size() == 4, "arrays keep all of their elements");
+    check(b[0].type == json_value::kind::boolean && b[0].boolean, "true is read");
+    check(b[1].type == json_value::kind::boolean && !b[1].boolean, "false is read");
+    check(std::isnan(b[2].as_number()), "null is read as NaN");
+    check(b[3].as_number() == -2e-3, "negative numbers with exponents are read");
+
+    check(v.at("c").type == json_value::kind::object && v.at("c").members().empty(),
+          "empty objects are read");
+    check(v.at("d").type == json_value::kind::array && v.at("d").elements().empty(),
+          "empty arrays are read");
+    check(v.at("e").text == "x\"y\\z\n", "escape sequences in strings are read");
+
+    // Copies share their contents with the original value
+    json_value const copy = v;
+    check(&copy.at("b").elements() == &b, "copies share array elements");
+
+    check_parse_error("{\"a\": 1,}", "trailing commas are rejected");
+    check_parse_error("{\"a\": TRUE}", "R-style logical values are rejected");
+    check_parse_error("{\"a\": \"unterminated}", "unterminated strings are rejected");
+    check_parse_error("[1, 2", "unterminated arrays are rejected");
+    check_parse_error("{} {}", "extra characters are rejected");
+
+    bool threw = false;
+    try {
+        v.at("missing");
+    } catch (std::runtime_error const&) {
+        threw = true;
+    }
+    check(threw, "at() rejects keys that are not present");
+}
+
+void test_csv_round_trip()
+{
+    string const filename = "io_test_round_trip.csv";
+
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+
+    state_vector_map const columns = {
+        {"time", {0.0, 1.0, 2.0}},
+        {"precise", {1.0 / 3.0, -1e-300, 123456789.123456789}},
+        {"missing", {nan, 4.0, nan}}};
+
+    write_csv_columns(columns, filename);
+    state_vector_map const result = read_csv_columns(filename);
+    std::remove(filename.c_str());
+
+    check(result.size() == columns.size(), "all CSV columns are read back");
+
+    for (auto const& column : columns) {
+        auto const it = result.find(column.first);
+        check(it != result.end(), "CSV column `" + column.first + "` is read back");
+        if (it == result.end()) {
+            continue;
+        }
+
+        check(it->second.size() == column.second.size(),
+              "CSV column `" + column.first + "` has the right length");
+
+        for (size_t i = 0; i < column.second.size() && i < it->second.size(); ++i) {
+            double const expected = column.second[i];
+            double const actual = it->second[i];
+            check(std::isnan(expected) ? std::isnan(actual) : actual == expected,
+                  "CSV column `" + column.first + "` row " + std::to_string(i) +
+                      " is read back exactly");
+        }
+    }
+}
+
+void test_writer_output(string const& filename)
+{
+    json_value const v = read_json_file(filename);
+
+    json_value const& initial_values = v.at("initial_values");
+    check(initial_values.at("Leaf").as_number() == 0.06312, "writer: decimal numbers");
+    check(initial_values.at("Stem").as_number() == 1e-300, "writer: tiny numbers");
+
+    json_value const& parameters = v.at("parameters");
+    check(parameters.at("Catm").as_number() == 400, "writer: whole numbers");
+    check(parameters.at("negative").as_number() == -2.5, "writer: negative numbers");
+    check(parameters.at("precise").as_number() == 1.0 / 3.0,
+          "writer: numbers keep full precision");
+    check(parameters.at("missing").type == json_value::kind::null, "writer: NA as null");
+    check(parameters.at("flag_true").type == json_value::kind::boolean &&
+              parameters.at("flag_true").boolean,
+          "writer: TRUE as true");
+    check(parameters.at("flag_false").type == json_value::kind::boolean &&
+              !parameters.at("flag_false").boolean,
+          "writer: FALSE as false");
+
+    check(v.at("direct_modules").type == json_value::kind::array &&
+              v.at("direct_modules").elements().empty(),
+          "writer: empty lists of modules as []");
+
+    json_value::array_type const& modules = v.at("differential_modules").elements();
+    check(modules.size() == 2 && modules[0].text == "BioCro:thermal_time_linear",
+          "writer: module names");
+    check(modules.size() == 2 &&
+              modules[1].text == "name with \"quotes\", \\ backslash, and\ttab",
+          "writer: strings with special characters");
+
+    check(v.at("ode_solver").type == json_value::kind::object &&
+              v.at("ode_solver").members().empty(),
+          "writer: empty lists as {}");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    try {
+        test_json_reader();
+        test_csv_round_trip();
+        if (argc > 1) {
+            test_writer_output(argv[1]);
+        }
+    } catch (std::exception const& e) {
+        std::cerr << "FAILED with an exception: " << e.what() << '\n';
+        return 1;
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+
+    std::cout << "All checks passed\n";
+    return 0;
+}